@@ -0,0 +1,44 @@
+/**
+ * Contoh autoBaud() tanpa hardware.
+ * MCP2515MockChip mensimulasikan node lain yang mengirim frame standar 8 byte di bus dengan
+ * bitrate tertentu; kandidat yang salah membaca setiap frame sebagai error (MERRF).
+ * Waktu yang dicetak adalah waktu virtual mock: lama frame nyata di bus plus transaksi SPI.
+ *
+ * Build: g++ -std=c++11 -I../.. autobaud_mock.cpp -o autobaud_mock
+ */
+#include <mcp2515-SUN.h>
+#include <mcp2515-SUN-mock.h>
+#include <stdio.h>
+
+typedef MCP2515Base<MCP2515MockSPI> CAN;
+
+int main()
+{
+    MCP2515MockChip chip;
+    CAN can(chip);
+    const uint32_t rates[] = {500000, 250000, 125000, 33333, 5000};
+    CAN::SPEED found;
+    uint32_t us;
+    byte res;
+
+    chip.oscHz = 16000000;
+    if (!can.initialize(CAN::REQ_NORMAL, CAN::IMOD_ANY, CAN::SPD_16MHz_1000K))
+        return 1;
+
+    for (uint8_t i = 0; i < sizeof(rates) / sizeof(rates[0]); i++)
+    {
+        chip.busBitrate = rates[i];
+        chip.busErrors = 0;
+        res = can.autoBaud(chip.oscHz, &found, &us);
+        printf("bus %6u bit/s: res %u, chip %6u bit/s, %6u us, %2u error frame, frame %u us, tx %u\n",
+               (unsigned)rates[i], res, (unsigned)chip.bitrate(), (unsigned)us, (unsigned)chip.busErrors,
+               (unsigned)MCP2515MockChip::frameUs(chip.busFrame, rates[i]), (unsigned)chip.sentCount);
+        if (res != CAN::RSPN_OK || chip.bitrate() != rates[i])
+            return 1;
+    }
+
+    chip.busBitrate = 0; // bus diam
+    res = can.autoBaud(chip.oscHz, &found, &us, 20);
+    printf("bus diam: res %u, %u us\n", res, (unsigned)us);
+    return (res == CAN::RSPN_NOMSG && chip.sentCount == 0) ? 0 : 1;
+}
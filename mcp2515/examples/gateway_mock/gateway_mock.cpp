@@ -0,0 +1,76 @@
+/**
+ * Contoh MCP2515Gateway tanpa hardware.
+ * Dua MCP2515MockChip mensimulasikan dua segmen CAN 500K yang penuh (frame standar 8 byte
+ * tanpa jeda) di kedua arah sekaligus. Keduanya berbagi satu bus SPI dan satu CPU, jadi waktu
+ * virtual dibagi; transport sisi B sengaja memakai jam dengan offset lain untuk menunjukkan
+ * bahwa latensi diukur dengan jam controller sumber.
+ *
+ * Build: g++ -std=c++11 -I../.. gateway_mock.cpp -o gateway_mock
+ */
+#include <mcp2515-SUN-gateway.h>
+#include <mcp2515-SUN-mock.h>
+#include <stdio.h>
+
+/**
+ * Transport mock yang menyinkronkan waktu virtual chip dengan jam bersama sebelum setiap
+ * transaksi, lalu menambahkan offset ke micros()/millis().
+ */
+class SharedClockSPI : public MCP2515MockSPI
+{
+private:
+    uint64_t *_clockNs;
+    uint32_t _offsetUs;
+
+public:
+    SharedClockSPI(MCP2515MockChip &chip, uint64_t &clockNs, uint32_t offsetUs)
+        : MCP2515MockSPI(chip), _clockNs(&clockNs), _offsetUs(offsetUs) {}
+
+    void transfer(const uint8_t *cmd, uint8_t cmdLen, const uint8_t *tx, uint8_t *rx, uint8_t n)
+    {
+        chip().nowNs = *_clockNs;
+        MCP2515MockSPI::transfer(cmd, cmdLen, tx, rx, n);
+        *_clockNs = chip().nowNs;
+    }
+    uint32_t micros(void) { return (uint32_t)(*_clockNs / 1000) + _offsetUs; }
+    uint32_t millis(void) { return micros() / 1000; }
+};
+
+typedef MCP2515Base<SharedClockSPI> CAN;
+
+int main()
+{
+    uint64_t clockNs = 0;
+    MCP2515MockChip chipA, chipB;
+    CAN canA(SharedClockSPI(chipA, clockNs, 0));
+    CAN canB(SharedClockSPI(chipB, clockNs, 0x80000000UL));
+    MCP2515Gateway<CAN> gw(canA, canB);
+
+    if (!canA.initialize(CAN::REQ_NORMAL, CAN::IMOD_ANY, CAN::SPD_16MHz_500K) ||
+        !canB.initialize(CAN::REQ_NORMAL, CAN::IMOD_ANY, CAN::SPD_16MHz_500K))
+        return 1;
+
+    uint8_t ab = gw.addRoute(gw.A_TO_B, 0x100, 0x700);              // 0x100..0x1FF diteruskan
+    uint8_t ba = gw.addRoute(gw.B_TO_A, 0x200, 0x700, 0x300, 0x700); // 0x2xx -> 0x3xx
+    gw.compile();
+
+    MCP2515MockChip::Frame fa = {0x123, 8, {1, 2, 3, 4, 5, 6, 7, 8}};
+    MCP2515MockChip::Frame fb = {0x234, 8, {8, 7, 6, 5, 4, 3, 2, 1}};
+    chipA.busFrame = fa;
+    chipB.busFrame = fb;
+    chipA.busBitrate = chipB.busBitrate = 500000;
+
+    while (chipA.busFrames < 1000 || chipB.busFrames < 1000)
+        gw.poll();
+
+    uint32_t frameUs = MCP2515MockChip::frameUs(fa, 500000);
+    const MCP2515Gateway<CAN>::RouteStats &sa = gw.stats(ab), &sb = gw.stats(ba);
+    printf("A->B: %u frame, latensi min/rata/maks %u/%u/%u us, overflow RX %u, terkirim %u (ID 0x%03X)\n",
+           (unsigned)sa.forwarded, (unsigned)sa.latMinUs, (unsigned)sa.latMeanUs(), (unsigned)sa.latMaxUs,
+           (unsigned)chipA.rxOverflow, (unsigned)chipB.sentCount, (unsigned)chipB.lastSent.id);
+    printf("B->A: %u frame, latensi min/rata/maks %u/%u/%u us, overflow RX %u, terkirim %u (ID 0x%03X)\n",
+           (unsigned)sb.forwarded, (unsigned)sb.latMinUs, (unsigned)sb.latMeanUs(), (unsigned)sb.latMaxUs,
+           (unsigned)chipB.rxOverflow, (unsigned)chipA.sentCount, (unsigned)chipA.lastSent.id);
+    printf("lama satu frame di bus: %u us\n", (unsigned)frameUs);
+
+    return (sa.latMaxUs < frameUs && sb.latMaxUs < frameUs && !chipA.rxOverflow && !chipB.rxOverflow) ? 0 : 1;
+}
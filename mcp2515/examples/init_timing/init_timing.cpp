@@ -0,0 +1,105 @@
+/**
+ * Contoh pengukuran initialize() tanpa hardware.
+ * legacyInit() mengulang urutan register-per-register yang dipakai initialize() sebelum image
+ * burst (satu transaksi SPI per register TX buffer, permintaan mode lewat _exitSleepMode), lalu
+ * hasilnya dibandingkan dengan initialize() sekarang: jumlah transaksi SPI, waktu virtual mock
+ * (SPI 10 MHz), dan isi register file setelahnya.
+ *
+ * Build: g++ -std=c++11 -I../.. init_timing.cpp -o init_timing
+ */
+#include <mcp2515-SUN.h>
+#include <mcp2515-SUN-mock.h>
+#include <stdio.h>
+
+typedef MCP2515Base<MCP2515MockSPI> CAN;
+
+static void wr(MCP2515MockSPI &spi, uint8_t addr, uint8_t val)
+{
+    const uint8_t cmd[3] = {0x02, addr, val};
+    spi.transfer(cmd, 3, 0, 0, 0);
+}
+
+static void wr4(MCP2515MockSPI &spi, uint8_t addr, const uint8_t val[4])
+{
+    const uint8_t cmd[2] = {0x02, addr};
+    spi.transfer(cmd, 2, val, 0, 4);
+}
+
+static void bm(MCP2515MockSPI &spi, uint8_t addr, uint8_t mask, uint8_t val)
+{
+    const uint8_t cmd[4] = {0x05, addr, mask, val};
+    spi.transfer(cmd, 4, 0, 0, 0);
+}
+
+static uint8_t rd(MCP2515MockSPI &spi, uint8_t addr)
+{
+    const uint8_t cmd[2] = {0x03, addr};
+    uint8_t v;
+    spi.transfer(cmd, 2, 0, &v, 1);
+    return v;
+}
+
+static void mode(MCP2515MockSPI &spi, uint8_t m)
+{
+    rd(spi, 0x0E);          // _exitSleepMode: CANSTAT
+    bm(spi, 0x2C, 0x40, 0); // _exitSleepMode: WAKIF
+    do
+        bm(spi, 0x0F, 0xE0, m);
+    while ((rd(spi, 0x0E) & 0xE0) != m);
+}
+
+static void legacyInit(MCP2515MockSPI &spi, uint32_t speed)
+{
+    static const uint8_t ext[4] = {0, 0x08, 0, 0}, std[4] = {0, 0, 0, 0};
+    uint8_t i, n;
+
+    mode(spi, 0x80);
+    wr(spi, 0x2A, (speed >> 16) & 0xFF);
+    wr(spi, 0x29, (speed >> 8) & 0xFF);
+    wr(spi, 0x28, speed & 0xFF);
+    wr4(spi, 0x20, ext);
+    wr4(spi, 0x24, ext);
+    for (i = 0; i < 6; i++)
+        wr4(spi, (i < 3 ? 0x00 : 0x10) + (i % 3) * 4, (i & 1) ? std : ext);
+    for (i = 0; i < 14; i++)
+        for (n = 0; n < 3; n++)
+            wr(spi, 0x30 + n * 0x10 + i, 0);
+    wr(spi, 0x60, 0);
+    wr(spi, 0x70, 0);
+    wr(spi, 0x2B, 0x03);       // CANINTE: RX0IE | RX1IE
+    wr(spi, 0x0C, 0x3C);       // BFPCTRL: BF pin sebagai GPO
+    wr(spi, 0x0D, 0x00);       // TXRTSCTRL
+    bm(spi, 0x60, 0x64, 0x64); // IMOD_ANY + BUKT
+    bm(spi, 0x70, 0x60, 0x60);
+    bm(spi, 0x0F, 0x08, 0);    // One-Shot Mode mati
+    mode(spi, 0x00);
+}
+
+int main()
+{
+    MCP2515MockChip oldChip, newChip;
+    MCP2515MockSPI oldSpi(oldChip);
+    CAN can(newChip);
+
+    uint64_t t0 = oldChip.nowNs;
+    legacyInit(oldSpi, CAN::SPD_16MHz_500K);
+    printf("register per register: %2u transaksi SPI, %3u us\n", (unsigned)oldChip.transactions,
+           (unsigned)((oldChip.nowNs - t0) / 1000));
+
+    t0 = newChip.nowNs;
+    if (!can.initialize(CAN::REQ_NORMAL, CAN::IMOD_ANY, CAN::SPD_16MHz_500K))
+        return 1;
+    printf("image burst:           %2u transaksi SPI, %3u us (lastInitMicros %u us)\n",
+           (unsigned)newChip.transactions, (unsigned)((newChip.nowNs - t0) / 1000),
+           (unsigned)can.lastInitMicros());
+
+    int diff = 0;
+    for (int a = 0; a < 0x80; a++)
+        if (oldChip.reg[a] != newChip.reg[a])
+        {
+            printf("register 0x%02X berbeda: %02X vs %02X\n", a, oldChip.reg[a], newChip.reg[a]);
+            diff++;
+        }
+    printf("register file %s\n", diff ? "BERBEDA" : "identik");
+    return diff ? 1 : 0;
+}
@@ -0,0 +1,63 @@
+/**
+ * Contoh reconfigure() tanpa hardware.
+ * Perubahan yang hanya menyentuh filter (dan interrupt) tidak boleh menulis blok mask,
+ * CNF3..CNF1, dan CANINTE (0x20..0x2B) selain CANINTE yang diminta. Stack sengaja dikotori
+ * lebih dulu supaya buffer yang tidak diisi akan terlihat di register.
+ *
+ * Build: g++ -std=c++11 -I../.. reconfig_mock.cpp -o reconfig_mock
+ */
+#include <mcp2515-SUN.h>
+#include <mcp2515-SUN-mock.h>
+#include <stdio.h>
+
+typedef MCP2515Base<MCP2515MockSPI> CAN;
+
+static void __attribute__((noinline)) dirtyStack(void)
+{
+    volatile uint8_t junk[512];
+    for (uint16_t i = 0; i < sizeof(junk); i++)
+        junk[i] = 0xA5;
+}
+
+static int check(const char *name, const uint8_t before[12], const MCP2515MockChip &chip, int inte)
+{
+    int diff = 0;
+    for (uint8_t a = 0; a < 12; a++)
+    {
+        uint8_t expect = (a == 11 && inte >= 0) ? (uint8_t)inte : before[a];
+        if (chip.reg[0x20 + a] != expect)
+        {
+            printf("%s: register 0x%02X %02X, seharusnya %02X\n", name, 0x20 + a, chip.reg[0x20 + a], expect);
+            diff++;
+        }
+    }
+    printf("%s: 0x20..0x2B %s, filter 0 = %02X %02X\n", name, diff ? "BERUBAH" : "utuh", chip.reg[0x00],
+           chip.reg[0x01]);
+    return diff;
+}
+
+int main()
+{
+    MCP2515MockChip chip;
+    CAN can(chip);
+    uint8_t before[12];
+    int diff = 0;
+
+    if (!can.initialize(CAN::REQ_NORMAL, CAN::IMOD_ANY, CAN::SPD_16MHz_500K))
+        return 1;
+    if (can.reconfigure().mask(0, 0x7F0).apply() != CAN::RSPN_OK)
+        return 1;
+    memcpy(before, &chip.reg[0x20], 12);
+
+    dirtyStack();
+    if (can.reconfigure().filter(0, 0x123).apply() != CAN::RSPN_OK)
+        return 1;
+    diff += check("filter", before, chip, -1);
+
+    dirtyStack();
+    if (can.reconfigure().filter(1, 0x456).interrupts(0x1F).apply() != CAN::RSPN_OK)
+        return 1;
+    diff += check("filter + interrupts", before, chip, 0x1F);
+
+    return diff ? 1 : 0;
+}
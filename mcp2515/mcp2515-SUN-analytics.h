@@ -0,0 +1,308 @@
+/**
+ * @file mcp2515-SUN-analytics.h
+ * @brief Analitik beban bus dan lalu lintas per ID untuk MCP2515
+ * @note Panjang setiap frame dihitung dalam bit di kabel, termasuk bit stuffing (dihitung persis
+ * dengan CRC-15), sehingga beban bus = total bit / (bitrate * lama jendela).
+ * @note Statistik per ID (jumlah, bit, DLC, jeda antar-kedatangan min/rata-rata/maks) disimpan di
+ * tabel hash berukuran tetap. ID yang tidak muat dihitung sebagai "untracked".
+ * @note Dua tabel dipakai bergantian: snapshot() menukar tabel aktif lalu membaca tabel lama,
+ * sehingga penerimaan frame tidak pernah dihentikan untuk ekspor.
+ * @note Contoh: if (can.readFrame(f) == MCP2515::RSPN_OK) stats.onFrame(f);
+ */
+
+#ifndef MCP2515_LIB_SUN_ANALYTICS_H
+#define MCP2515_LIB_SUN_ANALYTICS_H
+
+#include "mcp2515-SUN.h"
+
+/**
+ * @brief mcp2515Bitrate
+ * @param canSpeed Nilai SPEED (CNF1/CNF2/CNF3)
+ * @param oscHz Frekuensi kristal MCP2515 dalam Hz
+ * @return Bitrate dalam bit/detik
+ * @note Nilai SPEED tidak menyimpan frekuensi kristal (SPD_16MHz_100K == SPD_20MHz_125K),
+ * jadi frekuensi kristal harus diberikan.
+ */
+inline uint32_t mcp2515Bitrate(MCP2515Def::SPEED canSpeed, uint32_t oscHz)
+{
+    uint8_t cnf1 = (canSpeed >> 16) & 0xFF;
+    uint8_t cnf2 = (canSpeed >> 8) & 0xFF;
+    uint8_t cnf3 = canSpeed & 0xFF;
+    uint8_t brp = (cnf1 & 0x3F) + 1;
+    uint8_t prseg = (cnf2 & 0x07) + 1;
+    uint8_t ps1 = ((cnf2 >> 3) & 0x07) + 1;
+    uint8_t ps2 = (cnf2 & 0x80) ? (cnf3 & 0x07) + 1 : (ps1 > 2 ? ps1 : 2);
+    return oscHz / (2UL * brp * (1 + prseg + ps1 + ps2));
+}
+
+/**
+ * @brief MCP2515BitStuffer
+ * @note Menghitung bit, bit stuffing, dan CRC-15 dari field frame CAN (SOF sampai akhir CRC).
+ */
+class MCP2515BitStuffer
+{
+private:
+    uint8_t _run = 0;
+    uint8_t _last = 2;
+
+public:
+    uint16_t bits = 0;
+    uint16_t stuffed = 0;
+    uint16_t crc = 0;
+
+    void push(uint8_t b, bool withCrc = true)
+    {
+        if (withCrc)
+        {
+            uint8_t nxt = b ^ ((crc >> 14) & 1);
+            crc = (crc << 1) & 0x7FFF;
+            if (nxt)
+                crc ^= 0x4599;
+        }
+        bits++;
+        if (b == _last)
+            _run++;
+        else
+        {
+            _last = b;
+            _run = 1;
+        }
+        if (_run == 5)
+        {
+            stuffed++;
+            _last = !b; // bit stuffing berlawanan nilai dan memulai deretan baru
+            _run = 1;
+        }
+    }
+
+    void field(uint32_t v, uint8_t n, bool withCrc = true)
+    {
+        while (n--)
+            push((v >> n) & 1, withCrc);
+    }
+};
+
+/**
+ * @brief mcp2515FrameBits
+ * @param frame Frame CAN
+ * @return Jumlah bit frame di bus, termasuk bit stuffing, EOF, dan interframe space (3 bit)
+ */
+inline uint16_t mcp2515FrameBits(const MCP2515Frame &frame)
+{
+    MCP2515BitStuffer st;
+    bool rtr = frame.id & 0x40000000;
+    uint8_t len = frame.len > 8 ? 8 : frame.len;
+
+    st.push(0); // SOF
+    if (frame.id & 0x80000000)
+    {
+        uint32_t id = frame.id & 0x1FFFFFFF;
+        st.field(id >> 18, 11);
+        st.field(0x3, 2); // SRR, IDE
+        st.field(id & 0x3FFFF, 18);
+        st.field(rtr ? 0x4 : 0x0, 3); // RTR, r1, r0
+    }
+    else
+    {
+        st.field(frame.id & 0x7FF, 11);
+        st.field(rtr ? 0x4 : 0x0, 3); // RTR, IDE, r0
+    }
+    st.field(len, 4);
+    if (!rtr)
+        for (uint8_t i = 0; i < len; i++)
+            st.field(frame.data[i], 8);
+    st.field(st.crc, 15, false);
+
+    // CRC delimiter, ACK slot, ACK delimiter, EOF (7), interframe space (3)
+    return st.bits + st.stuffed + 13;
+}
+
+/**
+ * @brief MCP2515Analytics
+ * @tparam N Jumlah slot tabel ID per jendela (pangkat dua)
+ * @tparam K Jumlah top talker di snapshot
+ */
+template <uint16_t N = 64, uint8_t K = 8>
+class MCP2515Analytics
+{
+    static_assert((N & (N - 1)) == 0, "N harus pangkat dua");
+
+public:
+    struct IdStats
+    {
+        uint32_t id;
+        uint32_t count;
+        uint32_t bits;
+        uint32_t minGapUs;
+        uint32_t maxGapUs;
+        uint32_t sumGapUs;
+        uint32_t lastUs;
+        uint8_t dlc;
+
+        uint32_t meanGapUs(void) const { return (count > 1) ? sumGapUs / (count - 1) : 0; }
+    };
+
+    struct Snapshot
+    {
+        uint32_t startUs;       // awal jendela
+        uint32_t windowUs;      // lama jendela
+        uint32_t frames;        // frame RX
+        uint32_t txFrames;      // frame TX (onTx)
+        uint32_t busBits;       // total bit di bus
+        uint32_t untracked;     // frame dari ID yang tidak muat di tabel
+        uint16_t loadPermille;  // beban bus (0..1000)
+        uint16_t ids;           // jumlah ID berbeda
+        uint8_t topCount;       // jumlah entri valid di top
+        IdStats top[K];         // ID dengan bit terbanyak
+    };
+
+private:
+    struct Window
+    {
+        IdStats entry[N];
+        uint16_t ids;
+        uint32_t frames;
+        uint32_t txFrames;
+        uint32_t busBits;
+        uint32_t untracked;
+    };
+
+    Window _win[2];
+    uint32_t _bitrate;
+    uint32_t _startUs = 0;
+    volatile uint8_t _active = 0;
+    volatile uint8_t _writing = 0;
+
+    static uint16_t _hash(uint32_t id) { return (uint16_t)((id * 2654435761UL) >> 16) & (N - 1); }
+
+    static void _clear(Window &w)
+    {
+        memset(&w, 0, sizeof(Window));
+    }
+
+    void _account(const MCP2515Frame &frame, bool tx)
+    {
+        _writing = 1;
+        __sync_synchronize();
+        Window &w = _win[_active];
+        uint16_t bits = mcp2515FrameBits(frame);
+
+        w.busBits += bits;
+        if (tx)
+            w.txFrames++;
+        else
+            w.frames++;
+
+        uint16_t h = _hash(frame.id);
+        for (uint16_t i = 0; i < N; i++, h = (h + 1) & (N - 1))
+        {
+            IdStats &e = w.entry[h];
+            if (e.count == 0)
+            {
+                if (w.ids >= N - N / 8) // sisakan ruang agar probing tetap pendek
+                    break;
+                e.id = frame.id;
+                e.minGapUs = 0xFFFFFFFF;
+                w.ids++;
+            }
+            else if (e.id != frame.id)
+                continue;
+            if (e.count)
+            {
+                uint32_t gap = frame.timestamp - e.lastUs;
+                if (gap < e.minGapUs)
+                    e.minGapUs = gap;
+                if (gap > e.maxGapUs)
+                    e.maxGapUs = gap;
+                e.sumGapUs += gap;
+            }
+            e.count++;
+            e.bits += bits;
+            e.dlc = frame.len;
+            e.lastUs = frame.timestamp;
+            __sync_synchronize();
+            _writing = 0;
+            return;
+        }
+        w.untracked++;
+        __sync_synchronize();
+        _writing = 0;
+    }
+
+public:
+    MCP2515Analytics(uint32_t bitrate) : _bitrate(bitrate)
+    {
+        _clear(_win[0]);
+        _clear(_win[1]);
+    }
+
+    void setBitrate(uint32_t bitrate) { _bitrate = bitrate; }
+
+    /**
+     * @brief onFrame
+     * @param frame Frame yang diterima (timestamp dari readFrame())
+     */
+    void onFrame(const MCP2515Frame &frame) { _account(frame, false); }
+
+    /**
+     * @brief onTx
+     * @param frame Frame yang selesai dikirim (isi timestamp dengan waktu selesai)
+     */
+    void onTx(const MCP2515Frame &frame) { _account(frame, true); }
+
+    /**
+     * @brief snapshot
+     * @param out Hasil snapshot
+     * @param nowUs Waktu sekarang (micros) sebagai akhir jendela
+     * @note Menutup jendela aktif dan memulai jendela baru. Penulis tidak pernah menunggu;
+     * snapshot hanya menunggu update frame yang sedang berjalan (beberapa mikrodetik) selesai.
+     */
+    void snapshot(Snapshot &out, uint32_t nowUs)
+    {
+        uint8_t old = _active;
+        _active = old ^ 1;
+        __sync_synchronize();
+        while (_writing)
+            ;
+        Window &w = _win[old];
+
+        out.startUs = _startUs;
+        out.windowUs = nowUs - _startUs;
+        out.frames = w.frames;
+        out.txFrames = w.txFrames;
+        out.busBits = w.busBits;
+        out.untracked = w.untracked;
+        out.ids = w.ids;
+        out.loadPermille = (out.windowUs && _bitrate)
+                               ? (uint16_t)((uint64_t)w.busBits * 1000000000ULL / ((uint64_t)_bitrate * out.windowUs))
+                               : 0;
+        if (out.loadPermille > 1000)
+            out.loadPermille = 1000;
+        _startUs = nowUs;
+
+        // Top talker: seleksi parsial berdasarkan jumlah bit
+        out.topCount = 0;
+        for (uint16_t i = 0; i < N; i++)
+        {
+            const IdStats &e = w.entry[i];
+            if (e.count == 0)
+                continue;
+            uint8_t pos = out.topCount;
+            while (pos > 0 && out.top[pos - 1].bits < e.bits)
+            {
+                if (pos < K)
+                    out.top[pos] = out.top[pos - 1];
+                pos--;
+            }
+            if (pos < K)
+            {
+                out.top[pos] = e;
+                if (out.topCount < K)
+                    out.topCount++;
+            }
+        }
+        _clear(w);
+    }
+};
+
+#endif
@@ -0,0 +1,508 @@
+/**
+ * @file mcp2515-SUN-async.h
+ * @brief API coroutine C++20 (co_await) untuk MCP2515
+ * @note MCP2515Async membungkus satu driver: co_await port.receive(timeout), co_await port.send(frame),
+ * dan stream frame (port.frames()). MCP2515EventLoop (satu thread) melayani beberapa port sekaligus.
+ * @note Penyelesaian digerakkan oleh loop: setiap putaran port membaca RX buffer (readFrame(), atau
+ * rxService() jika setIrqDriven(true) sehingga SPI hanya dipakai setelah INT), memeriksa TXREQ dengan
+ * satu READ STATUS, lalu melanjutkan coroutine yang selesai.
+ * @note Tidak ada alokasi heap per frame: frame yang ditunggu disimpan di objek awaiter yang berada
+ * di coroutine frame, dan frame yang datang tanpa penunggu disimpan di antrean tetap milik port.
+ * Coroutine frame sendiri dialokasikan sekali saat coroutine dibuat.
+ * @note Contoh:
+ *   MCP2515EventLoop loop;
+ *   MCP2515Async<MCP2515> port(loop, can);
+ *   MCP2515Task echo(MCP2515Async<MCP2515> &p) {
+ *       for (auto s = p.frames(); const MCP2515Frame *f = co_await s.next();)
+ *           co_await p.send(*f);
+ *   }
+ *   echo(port); loop.run();
+ */
+
+#ifndef MCP2515_LIB_SUN_ASYNC_H
+#define MCP2515_LIB_SUN_ASYNC_H
+
+#if __cplusplus < 202002L || !defined(__has_include)
+#error "mcp2515-SUN-async.h membutuhkan C++20 (-std=c++20)"
+#elif !__has_include(<coroutine>)
+#error "mcp2515-SUN-async.h membutuhkan header <coroutine>"
+#endif
+
+#include <coroutine>
+#include <exception>
+#include "mcp2515-SUN.h"
+
+/**
+ * @brief MCP2515Task
+ * @note Tipe coroutine fire-and-forget: mulai langsung saat dipanggil dan menghapus dirinya
+ * sendiri saat selesai.
+ */
+struct MCP2515Task
+{
+    struct promise_type
+    {
+        MCP2515Task get_return_object(void) { return MCP2515Task(); }
+        std::suspend_never initial_suspend(void) noexcept { return {}; }
+        std::suspend_never final_suspend(void) noexcept { return {}; }
+        void return_void(void) {}
+        void unhandled_exception(void) { std::terminate(); }
+    };
+};
+
+/**
+ * @brief MCP2515RxResult
+ * @note Hasil co_await receive(): status RSPN_OK (frame valid), RSPN_NOMSG (timeout),
+ * atau RSPN_FAIL (port ditutup).
+ */
+struct MCP2515RxResult
+{
+    uint8_t status;
+    MCP2515Frame frame;
+};
+
+class MCP2515EventLoop;
+
+/**
+ * @brief MCP2515AsyncPort
+ * @note Basis untuk port yang dilayani MCP2515EventLoop.
+ */
+class MCP2515AsyncPort
+{
+    friend class MCP2515EventLoop;
+
+private:
+    MCP2515AsyncPort *_nextPort = 0;
+
+protected:
+    MCP2515EventLoop *_loop = 0;
+
+    /**
+     * @brief _service
+     * @return true jika ada coroutine yang dilanjutkan
+     */
+    virtual bool _service(void) = 0;
+    ~MCP2515AsyncPort() {}
+};
+
+/**
+ * @brief MCP2515EventLoop
+ * @note Event loop satu thread. Semua coroutine dilanjutkan dari runOnce()/run().
+ */
+class MCP2515EventLoop
+{
+public:
+    typedef void (*IdleHook)(void *ctx);
+
+private:
+    MCP2515AsyncPort *_ports = 0;
+    volatile bool _running = false;
+    IdleHook _idle = 0;
+    void *_idleCtx = 0;
+
+public:
+    void add(MCP2515AsyncPort *port)
+    {
+        port->_nextPort = _ports;
+        _ports = port;
+        port->_loop = this;
+    }
+
+    void remove(MCP2515AsyncPort *port)
+    {
+        for (MCP2515AsyncPort **pp = &_ports; *pp; pp = &(*pp)->_nextPort)
+            if (*pp == port)
+            {
+                *pp = port->_nextPort;
+                port->_loop = 0;
+                return;
+            }
+    }
+
+    /**
+     * @brief setIdle
+     * @param hook Dipanggil run() saat tidak ada pekerjaan (mis. tunggu INT, sleep, atau yield)
+     * @param ctx Argumen untuk hook
+     */
+    void setIdle(IdleHook hook, void *ctx = 0)
+    {
+        _idle = hook;
+        _idleCtx = ctx;
+    }
+
+    /**
+     * @brief runOnce
+     * @return true jika ada coroutine yang dilanjutkan
+     */
+    bool runOnce(void)
+    {
+        bool work = false;
+        for (MCP2515AsyncPort *p = _ports; p; p = p->_nextPort)
+            work |= p->_service();
+        return work;
+    }
+
+    /**
+     * @brief run
+     * @note Melayani semua port sampai stop() dipanggil.
+     */
+    void run(void)
+    {
+        _running = true;
+        while (_running)
+            if (!runOnce() && _idle)
+                _idle(_idleCtx);
+    }
+
+    void stop(void) { _running = false; }
+};
+
+/**
+ * @brief MCP2515Async
+ * @tparam DRIVER Tipe driver, mis. MCP2515 atau MCP2515Base<MCP2515LinuxSPI>
+ * @tparam QLEN Panjang antrean RX software (pangkat dua)
+ */
+template <class DRIVER, uint8_t QLEN = 16>
+class MCP2515Async : public MCP2515AsyncPort
+{
+    static_assert((QLEN & (QLEN - 1)) == 0, "QLEN harus pangkat dua");
+
+public:
+    class RecvAwaiter
+    {
+        friend class MCP2515Async;
+
+    private:
+        MCP2515Async &_port;
+        uint32_t _timeoutUs;
+        uint32_t _startUs = 0;
+        RecvAwaiter *_next = 0;
+        std::coroutine_handle<> _h;
+
+    protected:
+        MCP2515RxResult _res;
+
+    public:
+        RecvAwaiter(MCP2515Async &port, uint32_t timeoutUs) : _port(port), _timeoutUs(timeoutUs) {}
+
+        bool await_ready(void) { return _port._tryRecv(_res); }
+
+        void await_suspend(std::coroutine_handle<> h)
+        {
+            _h = h;
+            _startUs = _port._now();
+            _port._push(_port._rxHead, _port._rxTail, this);
+        }
+
+        MCP2515RxResult await_resume(void) { return _res; }
+    };
+
+    class SendAwaiter
+    {
+        friend class MCP2515Async;
+
+    private:
+        MCP2515Async &_port;
+        MCP2515Frame _frame;
+        uint32_t _timeoutUs;
+        uint32_t _startUs = 0;
+        SendAwaiter *_next = 0;
+        std::coroutine_handle<> _h;
+        uint8_t _txbuf = 0xFF; // 0xFF = belum dimuat ke TX buffer
+        uint8_t _txp = 0;
+        bool _aborted = false;
+        uint8_t _res = MCP2515Def::RSPN_FAIL;
+
+    public:
+        SendAwaiter(MCP2515Async &port, const MCP2515Frame &frame, uint32_t timeoutUs)
+            : _port(port), _frame(frame), _timeoutUs(timeoutUs) {}
+
+        bool await_ready(void) { return _port._closed; }
+
+        void await_suspend(std::coroutine_handle<> h)
+        {
+            _h = h;
+            _startUs = _port._now();
+            _port._push(_port._txHead, _port._txTail, this);
+            _port._load(_port._can.txPending());
+        }
+
+        uint8_t await_resume(void) { return _res; }
+    };
+
+    /**
+     * @brief Stream
+     * @note Stream frame masuk: co_await next() menghasilkan pointer ke frame (disimpan di objek
+     * Stream, valid sampai next() berikutnya) atau 0 jika port ditutup.
+     */
+    class Stream
+    {
+    private:
+        MCP2515Async &_port;
+        MCP2515Frame _frame;
+
+    public:
+        class NextAwaiter : public RecvAwaiter
+        {
+        private:
+            Stream &_s;
+
+        public:
+            NextAwaiter(Stream &s) : RecvAwaiter(s._port, 0), _s(s) {}
+
+            const MCP2515Frame *await_resume(void)
+            {
+                if (this->_res.status != MCP2515Def::RSPN_OK)
+                    return 0;
+                _s._frame = this->_res.frame;
+                return &_s._frame;
+            }
+        };
+
+        Stream(MCP2515Async &port) : _port(port) {}
+        NextAwaiter next(void) { return NextAwaiter(*this); }
+    };
+
+private:
+    DRIVER &_can;
+    MCP2515Frame _q[QLEN];
+    uint8_t _qHead = 0;
+    uint8_t _qTail = 0;
+    RecvAwaiter *_rxHead = 0;
+    RecvAwaiter *_rxTail = 0;
+    SendAwaiter *_txHead = 0;
+    SendAwaiter *_txTail = 0;
+    bool _irq = false;
+    bool _closed = false;
+
+    uint32_t _now(void) { return _can.transport().micros(); }
+
+    template <class W>
+    static void _push(W *&head, W *&tail, W *w)
+    {
+        w->_next = 0;
+        if (tail)
+            tail->_next = w;
+        else
+            head = w;
+        tail = w;
+    }
+
+    /**
+     * @brief _pull
+     * @note Memindahkan frame dari RX buffer chip ke antrean software selama masih ada tempat.
+     */
+    void _pull(void)
+    {
+        uint8_t space = QLEN - (uint8_t)(_qHead - _qTail);
+        while (space)
+        {
+            uint8_t slot = _qHead & (QLEN - 1);
+            uint8_t n = 0;
+            if (_irq)
+            {
+                uint8_t span = QLEN - slot;
+                n = _can.rxService(&_q[slot], span < space ? span : space);
+            }
+            else if (_can.readFrame(_q[slot]) == MCP2515Def::RSPN_OK)
+                n = 1;
+            if (n == 0)
+                break;
+            _qHead += n;
+            space -= n;
+        }
+    }
+
+    bool _tryRecv(MCP2515RxResult &res)
+    {
+        if (_closed)
+        {
+            res.status = MCP2515Def::RSPN_FAIL;
+            return true;
+        }
+        if (_rxHead)
+            return false; // penunggu lain lebih dulu
+        if (_qHead == _qTail)
+            _pull();
+        if (_qHead == _qTail)
+            return false;
+        res.status = MCP2515Def::RSPN_OK;
+        res.frame = _q[_qTail++ & (QLEN - 1)];
+        return true;
+    }
+
+    /**
+     * @brief _load
+     * @param pend Bit TXREQ saat ini (txPending())
+     * @note Memuat frame yang belum dimuat, berurutan. Frame yang dimuat belakangan diberi TXP lebih
+     * rendah agar urutan di bus sama dengan urutan co_await send().
+     */
+    void _load(uint8_t pend)
+    {
+        uint8_t minp = 4;
+        SendAwaiter *w;
+
+        for (w = _txHead; w && w->_txbuf != 0xFF; w = w->_next)
+            if ((pend & (1 << w->_txbuf)) && w->_txp < minp)
+                minp = w->_txp;
+        for (; w && minp; w = w->_next)
+        {
+            uint8_t txp = (minp > 3) ? 3 : minp - 1;
+            if (_can.queueFrame(w->_frame, txp, &w->_txbuf) != MCP2515Def::RSPN_OK)
+            {
+                w->_txbuf = 0xFF;
+                break;
+            }
+            w->_txp = minp = txp;
+        }
+    }
+
+    bool _service(void) override
+    {
+        RecvAwaiter *rdone = 0, *rdoneTail = 0;
+        SendAwaiter *sdone = 0, *sdoneTail = 0;
+        uint32_t now;
+
+        _pull();
+        now = _now();
+
+        // RX: frame untuk penunggu, lalu timeout
+        while (_rxHead && _qHead != _qTail)
+        {
+            RecvAwaiter *w = _rxHead;
+            if (!(_rxHead = w->_next))
+                _rxTail = 0;
+            w->_res.status = MCP2515Def::RSPN_OK;
+            w->_res.frame = _q[_qTail++ & (QLEN - 1)];
+            _push(rdone, rdoneTail, w);
+        }
+        for (RecvAwaiter **pw = &_rxHead, *prev = 0; *pw;)
+        {
+            RecvAwaiter *w = *pw;
+            if (_closed || (w->_timeoutUs && now - w->_startUs >= w->_timeoutUs))
+            {
+                *pw = w->_next;
+                if (_rxTail == w)
+                    _rxTail = prev;
+                w->_res.status = _closed ? MCP2515Def::RSPN_FAIL : MCP2515Def::RSPN_NOMSG;
+                _push(rdone, rdoneTail, w);
+            }
+            else
+            {
+                prev = w;
+                pw = &w->_next;
+            }
+        }
+
+        // TX: selesai, timeout, lalu muat frame berikutnya
+        if (_txHead)
+        {
+            uint8_t pend = _can.txPending();
+            for (SendAwaiter **pw = &_txHead, *prev = 0; *pw;)
+            {
+                SendAwaiter *w = *pw;
+                bool done = false;
+                bool late = w->_timeoutUs && now - w->_startUs >= w->_timeoutUs;
+
+                if (w->_txbuf != 0xFF)
+                {
+                    if (!(pend & (1 << w->_txbuf)))
+                    {
+                        w->_res = _can.txResult(w->_txbuf);
+                        if (w->_aborted && w->_res != MCP2515Def::RSPN_OK)
+                            w->_res = MCP2515Def::RSPN_SENDMSGTIMEOUT;
+                        done = true;
+                    }
+                    else if (late && !w->_aborted)
+                    {
+                        _can.abortTx(w->_txbuf); // hasil dibaca setelah TXREQ bernilai 0
+                        w->_aborted = true;
+                    }
+                }
+                else if (_closed || late)
+                {
+                    w->_res = _closed ? MCP2515Def::RSPN_FAIL : MCP2515Def::RSPN_GETTXBFTIMEOUT;
+                    done = true;
+                }
+
+                if (done)
+                {
+                    *pw = w->_next;
+                    if (_txTail == w)
+                        _txTail = prev;
+                    _push(sdone, sdoneTail, w);
+                }
+                else
+                {
+                    prev = w;
+                    pw = &w->_next;
+                }
+            }
+            _load(pend);
+        }
+
+        // Lanjutkan coroutine setelah semua antrean konsisten (coroutine boleh langsung co_await lagi)
+        bool work = rdone || sdone;
+        while (rdone)
+        {
+            RecvAwaiter *w = rdone;
+            rdone = w->_next;
+            w->_h.resume();
+        }
+        while (sdone)
+        {
+            SendAwaiter *w = sdone;
+            sdone = w->_next;
+            w->_h.resume();
+        }
+        return work;
+    }
+
+public:
+    MCP2515Async(MCP2515EventLoop &loop, DRIVER &can) : _can(can) { loop.add(this); }
+
+    ~MCP2515Async()
+    {
+        if (_loop)
+            _loop->remove(this);
+    }
+
+    /**
+     * @brief receive
+     * @param timeoutUs Batas waktu menunggu (0 = tanpa batas)
+     * @return Awaiter yang menghasilkan MCP2515RxResult
+     */
+    RecvAwaiter receive(uint32_t timeoutUs = 0) { return RecvAwaiter(*this, timeoutUs); }
+
+    /**
+     * @brief send
+     * @param frame Frame yang dikirim (disalin ke awaiter)
+     * @param timeoutUs Batas waktu sampai frame terkirim (0 = tanpa batas)
+     * @return Awaiter yang menghasilkan RSPN_OK, RSPN_FAILTX, RSPN_GETTXBFTIMEOUT (belum sempat dimuat),
+     * RSPN_SENDMSGTIMEOUT (dimuat tetapi dibatalkan), atau RSPN_FAIL (port ditutup)
+     * @note Frame dari beberapa send() yang menunggu dikirim berurutan.
+     */
+    SendAwaiter send(const MCP2515Frame &frame, uint32_t timeoutUs = 0) { return SendAwaiter(*this, frame, timeoutUs); }
+
+    /**
+     * @brief frames
+     * @return Stream frame masuk
+     */
+    Stream frames(void) { return Stream(*this); }
+
+    /**
+     * @brief setIrqDriven
+     * @param enable true = baca RX lewat rxService() (panggil can.rxIrq() dari ISR pin INT)
+     */
+    void setIrqDriven(bool enable) { _irq = enable; }
+
+    /**
+     * @brief close
+     * @note Semua receive() yang menunggu selesai dengan RSPN_FAIL, stream menghasilkan 0.
+     * Frame yang sudah dimuat ke TX buffer tetap dikirim.
+     */
+    void close(void) { _closed = true; }
+
+    uint8_t queued(void) const { return (uint8_t)(_qHead - _qTail); }
+};
+
+#endif
@@ -0,0 +1,336 @@
+/**
+ * @file mcp2515-SUN-gateway.h
+ * @brief Gateway cut-through antara dua controller MCP2515
+ * @note Aturan routing (izin/tolak ID, rewrite ID, batas laju per route) dikompilasi menjadi
+ * tabel lookup untuk 2048 ID standar per arah; ID extended dicocokkan berurutan.
+ * @note TX tidak pernah menunggu: setiap arah punya antrean software, dan frame dimuat ke
+ * TX buffer kosong dengan queueFrame(). Urutan frame dijaga dengan TXP yang menurun untuk
+ * frame yang dimuat belakangan.
+ * @note Latensi diukur dari saat frame dibaca dari controller sumber (MCP2515Frame::timestamp)
+ * sampai frame dimuat ke TX buffer controller tujuan, keduanya dengan jam transport sumber,
+ * sehingga kedua driver boleh memakai sumber waktu yang berbeda.
+ * @note Contoh:
+ *   MCP2515Gateway<MCP2515> gw(canA, canB);
+ *   gw.addRoute(gw.A_TO_B, 0x100, 0x700);                      // 0x100..0x1FF diteruskan
+ *   gw.addRoute(gw.B_TO_A, 0x200, 0x7FF, 0x300, 0x7FF, 100);   // 0x200 -> 0x300, maks 100 fps
+ *   gw.addDeny(gw.B_TO_A, 0x000, 0x000);                       // sisanya ditolak
+ *   gw.compile();
+ *   void loop() { gw.poll(); }
+ */
+
+#ifndef MCP2515_LIB_SUN_GATEWAY_H
+#define MCP2515_LIB_SUN_GATEWAY_H
+
+#include "mcp2515-SUN.h"
+
+/**
+ * @brief MCP2515Gateway
+ * @tparam DRIVER_A Tipe driver sisi A
+ * @tparam DRIVER_B Tipe driver sisi B
+ * @tparam QLEN Panjang antrean software per arah (pangkat dua)
+ * @tparam MAXROUTES Jumlah maksimum aturan
+ */
+template <class DRIVER_A, class DRIVER_B = DRIVER_A, uint8_t QLEN = 16, uint8_t MAXROUTES = 16>
+class MCP2515Gateway
+{
+    static_assert((QLEN & (QLEN - 1)) == 0, "QLEN harus pangkat dua");
+    static_assert(MAXROUTES < 0xFE, "MAXROUTES terlalu besar");
+
+public:
+    enum DIR
+    {
+        A_TO_B = 0,
+        B_TO_A = 1,
+    };
+    enum
+    {
+        ROUTE_NONE = 0xFF,
+    };
+
+    struct RouteStats
+    {
+        uint32_t forwarded;
+        uint32_t deniedDrops;  // ditolak aturan
+        uint32_t rateDrops;    // melebihi batas laju
+        uint32_t queueDrops;   // antrean penuh
+        uint32_t latMinUs;
+        uint32_t latMaxUs;
+        uint32_t latSumUs;
+
+        uint32_t latMeanUs(void) const { return forwarded ? latSumUs / forwarded : 0; }
+    };
+
+private:
+    struct Route
+    {
+        uint32_t id;
+        uint32_t mask;
+        uint32_t rwValue;
+        uint32_t rwMask;
+        uint32_t costUs;   // 1e6 / fps, 0 = tanpa batas
+        uint32_t creditUs; // token bucket dalam mikrodetik
+        uint32_t burstUs;
+        uint32_t lastUs;
+        uint8_t dir;
+        bool deny;
+    };
+
+    struct Queue
+    {
+        MCP2515Frame frame[QLEN];
+        uint8_t route[QLEN];
+        uint8_t head;
+        uint8_t tail;
+    };
+
+    DRIVER_A &_a;
+    DRIVER_B &_b;
+    Route _route[MAXROUTES + 2]; // + route default per arah
+    RouteStats _stats[MAXROUTES + 2];
+    uint8_t _nRoutes = 0;
+    uint8_t _std[2][2048]; // ID standar -> indeks route
+    Queue _q[2];
+    uint8_t _txp[2][3]; // TXP yang dipakai gateway per TX buffer tujuan
+    uint32_t _maxAgeUs = 0;
+
+    uint8_t _defaultRoute(uint8_t dir) const { return MAXROUTES + dir; }
+
+    uint8_t _match(uint8_t dir, uint32_t id) const
+    {
+        for (uint8_t i = 0; i < _nRoutes; i++)
+            if (_route[i].dir == dir && ((id ^ _route[i].id) & _route[i].mask) == 0)
+                return i;
+        return _defaultRoute(dir);
+    }
+
+    uint8_t _lookup(uint8_t dir, uint32_t id) const
+    {
+        if (!(id & 0x80000000))
+            return _std[dir][id & 0x7FF];
+        return _match(dir, id & 0x9FFFFFFF);
+    }
+
+    bool _allowRate(Route &r, uint32_t now)
+    {
+        if (!r.costUs)
+            return true;
+        uint32_t credit = r.creditUs + (now - r.lastUs);
+        r.lastUs = now;
+        if (credit > r.burstUs || credit < r.creditUs) // juga menangani overflow
+            credit = r.burstUs;
+        if (credit < r.costUs)
+        {
+            r.creditUs = credit;
+            return false;
+        }
+        r.creditUs = credit - r.costUs;
+        return true;
+    }
+
+    void _forward(uint8_t dir, MCP2515Frame &frame)
+    {
+        uint8_t ri = _lookup(dir, frame.id);
+        Route &r = _route[ri];
+        RouteStats &st = _stats[ri];
+
+        if (r.deny)
+        {
+            st.deniedDrops++;
+            return;
+        }
+        if (!_allowRate(r, frame.timestamp))
+        {
+            st.rateDrops++;
+            return;
+        }
+        Queue &q = _q[dir];
+        if ((uint8_t)(q.head - q.tail) >= QLEN)
+        {
+            st.queueDrops++;
+            return;
+        }
+        frame.id = (frame.id & ~r.rwMask) | (r.rwValue & r.rwMask);
+        q.frame[q.head & (QLEN - 1)] = frame;
+        q.route[q.head & (QLEN - 1)] = ri;
+        q.head++;
+    }
+
+    template <class SRC, class DST>
+    uint8_t _pump(uint8_t dir, SRC &src, DST &dst)
+    {
+        Queue &q = _q[dir];
+        uint8_t sent = 0, txbuf, pend, minp = 4;
+
+        if (q.head == q.tail)
+            return 0;
+        pend = dst.txPending();
+        for (uint8_t b = 0; b < 3; b++)
+            if ((pend & (1 << b)) && _txp[dir][b] < minp)
+                minp = _txp[dir][b];
+
+        while (q.head != q.tail)
+        {
+            uint8_t slot = q.tail & (QLEN - 1);
+            MCP2515Frame &frame = q.frame[slot];
+            RouteStats &st = _stats[q.route[slot]];
+            uint32_t now = src.transport().micros(); // jam yang sama dengan frame.timestamp
+
+            if (_maxAgeUs && (now - frame.timestamp) > _maxAgeUs)
+            {
+                st.queueDrops++; // basi sebelum sempat dimuat
+                q.tail++;
+                continue;
+            }
+            // Frame yang dimuat belakangan diberi TXP lebih rendah agar urutan terjaga
+            if (minp == 0)
+                break;
+            uint8_t txp = (minp > 3) ? 3 : minp - 1;
+            if (dst.queueFrame(frame, txp, &txbuf) != MCP2515Def::RSPN_OK)
+                break;
+            _txp[dir][txbuf] = txp;
+            minp = txp;
+
+            uint32_t lat = now - frame.timestamp;
+            if (st.forwarded == 0 || lat < st.latMinUs)
+                st.latMinUs = lat;
+            if (lat > st.latMaxUs)
+                st.latMaxUs = lat;
+            st.latSumUs += lat;
+            st.forwarded++;
+            q.tail++;
+            sent++;
+        }
+        return sent;
+    }
+
+public:
+    MCP2515Gateway(DRIVER_A &a, DRIVER_B &b) : _a(a), _b(b)
+    {
+        memset(_route, 0, sizeof(_route));
+        memset(_stats, 0, sizeof(_stats));
+        memset(_q, 0, sizeof(_q));
+        memset(_txp, 0, sizeof(_txp));
+        _route[_defaultRoute(A_TO_B)].dir = A_TO_B;
+        _route[_defaultRoute(B_TO_A)].dir = B_TO_A;
+        compile();
+    }
+
+    /**
+     * @brief addRoute
+     * @param dir Arah (A_TO_B / B_TO_A)
+     * @param id ID yang dicocokkan (bit 31 = extended)
+     * @param mask Bit ID yang dibandingkan
+     * @param rwValue Nilai ID baru untuk bit pada rwMask
+     * @param rwMask Bit ID yang ditulis ulang (0 = tanpa rewrite)
+     * @param rateFps Batas laju frame per detik (0 = tanpa batas)
+     * @param burst Jumlah frame yang boleh lewat berturut-turut
+     * @return Indeks route atau ROUTE_NONE jika tabel penuh
+     * @note Aturan dicocokkan berurutan, aturan pertama yang cocok dipakai. Panggil compile() setelahnya.
+     */
+    uint8_t addRoute(uint8_t dir, uint32_t id, uint32_t mask, uint32_t rwValue = 0, uint32_t rwMask = 0,
+                     uint16_t rateFps = 0, uint16_t burst = 1)
+    {
+        if (_nRoutes >= MAXROUTES)
+            return ROUTE_NONE;
+        Route &r = _route[_nRoutes];
+        r.dir = dir;
+        r.id = id & 0x9FFFFFFF;
+        r.mask = mask | 0x80000000; // standar dan extended tidak pernah tertukar
+        r.rwValue = rwValue;
+        r.rwMask = rwMask & 0x1FFFFFFF;
+        r.costUs = rateFps ? 1000000UL / rateFps : 0;
+        r.burstUs = r.costUs * (burst ? burst : 1);
+        r.creditUs = r.burstUs;
+        r.deny = false;
+        return _nRoutes++;
+    }
+
+    /**
+     * @brief addDeny
+     * @param dir Arah (A_TO_B / B_TO_A)
+     * @param id ID yang dicocokkan
+     * @param mask Bit ID yang dibandingkan (0 = semua ID)
+     * @return Indeks route atau ROUTE_NONE jika tabel penuh
+     */
+    uint8_t addDeny(uint8_t dir, uint32_t id, uint32_t mask)
+    {
+        uint8_t i = addRoute(dir, id, mask);
+        if (i != ROUTE_NONE)
+            _route[i].deny = true;
+        return i;
+    }
+
+    /**
+     * @brief setDefault
+     * @param dir Arah (A_TO_B / B_TO_A)
+     * @param allow true = ID tanpa aturan diteruskan, false = ditolak (default: diteruskan)
+     */
+    void setDefault(uint8_t dir, bool allow) { _route[_defaultRoute(dir)].deny = !allow; }
+
+    /**
+     * @brief setMaxAge
+     * @param us Umur maksimum frame di antrean software (0 = tanpa batas)
+     */
+    void setMaxAge(uint32_t us) { _maxAgeUs = us; }
+
+    /**
+     * @brief compile
+     * @note Membangun tabel lookup ID standar dari aturan saat ini.
+     */
+    void compile(void)
+    {
+        for (uint8_t dir = 0; dir < 2; dir++)
+            for (uint16_t id = 0; id < 2048; id++)
+                _std[dir][id] = _match(dir, id);
+    }
+
+    /**
+     * @brief poll
+     * @param budget Jumlah maksimum frame yang dibaca per arah dalam satu panggilan
+     * @return Jumlah frame yang dimuat ke TX buffer
+     * @note Kedua arah dilayani bergantian sehingga satu arah yang sibuk tidak menahan arah lain.
+     */
+    uint8_t poll(uint8_t budget = 4)
+    {
+        MCP2515Frame frame;
+        uint8_t sent = 0;
+
+        for (uint8_t i = 0; i < budget; i++)
+        {
+            bool got = false;
+            if (_a.readFrame(frame) == MCP2515Def::RSPN_OK)
+            {
+                _forward(A_TO_B, frame);
+                got = true;
+            }
+            if (_b.readFrame(frame) == MCP2515Def::RSPN_OK)
+            {
+                _forward(B_TO_A, frame);
+                got = true;
+            }
+            sent += _pump(A_TO_B, _a, _b);
+            sent += _pump(B_TO_A, _b, _a);
+            if (!got)
+                break;
+        }
+        return sent;
+    }
+
+    /**
+     * @brief stats
+     * @param route Indeks route dari addRoute()/addDeny()
+     * @return Statistik route
+     */
+    const RouteStats &stats(uint8_t route) const { return _stats[route]; }
+
+    /**
+     * @brief defaultStats
+     * @param dir Arah (A_TO_B / B_TO_A)
+     * @return Statistik untuk frame yang tidak cocok dengan aturan mana pun
+     */
+    const RouteStats &defaultStats(uint8_t dir) const { return _stats[_defaultRoute(dir)]; }
+
+    uint8_t queued(uint8_t dir) const { return (uint8_t)(_q[dir].head - _q[dir].tail); }
+};
+
+#endif
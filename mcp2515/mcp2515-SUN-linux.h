@@ -0,0 +1,390 @@
+/**
+ * @file mcp2515-SUN-linux.h
+ * @brief Mode host Linux: daemon userspace untuk MCP2515 melalui spidev
+ * @note MCP2515LinuxDaemon menunggu tepi turun pin INT dengan epoll (bukan polling available()),
+ * menguras RX buffer lewat readFrame(), lalu menerbitkan frame ke MCP2515ShmRing.
+ * @note MCP2515ShmRing adalah ring buffer shared memory satu produsen banyak konsumen.
+ * Setiap proses konsumen membaca dengan MCP2515ShmReader sesuai kecepatannya sendiri,
+ * tanpa syscall per frame. Konsumen yang tertinggal lebih dari kapasitas ring kehilangan frame
+ * tertua (dihitung di lost()).
+ * @note Untuk pengujian tanpa hardware: pakai MCP2515MockChip sebagai chip dan eventfd sebagai
+ * pengganti GPIO (lihat examples/linux_host).
+ */
+
+#ifndef MCP2515_LIB_SUN_LINUX_H
+#define MCP2515_LIB_SUN_LINUX_H
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "mcp2515-SUN.h"
+
+#include <atomic>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <linux/gpio.h>
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "MCP2515ShmRing membutuhkan atomic 64-bit yang lock-free");
+
+/**
+ * @brief MCP2515ShmRing
+ * @note Layout: header lalu `capacity` slot. Setiap slot dilindungi nomor urut (seqlock):
+ * ganjil = sedang ditulis, 2 * (posisi + 1) = frame pada posisi tersebut sudah lengkap.
+ */
+class MCP2515ShmRing
+{
+public:
+    struct Slot
+    {
+        std::atomic<uint64_t> seq;
+        MCP2515Frame frame;
+    };
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t capacity; // pangkat dua
+        std::atomic<uint64_t> head; // posisi tulis berikutnya
+    };
+
+    enum
+    {
+        SHM_MAGIC = 0x4D435032, // "MCP2"
+    };
+
+private:
+    Header *_hdr = 0;
+    Slot *_slots = 0;
+    size_t _size = 0;
+    uint64_t _mask = 0;
+
+    static size_t _bytes(uint32_t capacity) { return sizeof(Header) + (size_t)capacity * sizeof(Slot); }
+
+    bool _map(int fd, size_t size)
+    {
+        void *p = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (p == MAP_FAILED)
+            return false;
+        _hdr = (Header *)p;
+        _slots = (Slot *)(_hdr + 1);
+        _size = size;
+        return true;
+    }
+
+public:
+    ~MCP2515ShmRing() { detach(); }
+
+    /**
+     * @brief create
+     * @param name Nama objek shm_open (mis. "/mcp2515")
+     * @param capacity Jumlah slot, dibulatkan ke atas menjadi pangkat dua
+     * @return true jika berhasil
+     * @note Dipanggil oleh proses produsen (daemon).
+     */
+    bool create(const char *name, uint32_t capacity)
+    {
+        uint32_t cap = 1;
+        while (cap < capacity)
+            cap <<= 1;
+        int fd = shm_open(name, O_CREAT | O_RDWR, 0660);
+        if (fd < 0)
+            return false;
+        if (ftruncate(fd, _bytes(cap)) < 0 || !_map(fd, _bytes(cap)))
+            return false;
+        for (uint32_t i = 0; i < cap; i++)
+            _slots[i].seq.store(0, std::memory_order_relaxed);
+        _hdr->capacity = cap;
+        _hdr->head.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        _hdr->magic = SHM_MAGIC;
+        _mask = cap - 1;
+        return true;
+    }
+
+    /**
+     * @brief attach
+     * @param name Nama objek shm_open yang dibuat oleh create()
+     * @return true jika berhasil
+     * @note Dipanggil oleh proses konsumen.
+     */
+    bool attach(const char *name)
+    {
+        Header h;
+        int fd = shm_open(name, O_RDWR, 0);
+        if (fd < 0)
+            return false;
+        if (pread(fd, &h, sizeof(uint32_t) * 2, 0) != (ssize_t)(sizeof(uint32_t) * 2) || h.magic != SHM_MAGIC)
+        {
+            close(fd);
+            return false;
+        }
+        if (!_map(fd, _bytes(h.capacity)))
+            return false;
+        _mask = _hdr->capacity - 1;
+        return true;
+    }
+
+    void detach(void)
+    {
+        if (_hdr)
+            munmap(_hdr, _size);
+        _hdr = 0;
+        _slots = 0;
+    }
+
+    static void unlink(const char *name) { shm_unlink(name); }
+
+    uint32_t capacity(void) const { return _hdr ? _hdr->capacity : 0; }
+    uint64_t head(void) const { return _hdr->head.load(std::memory_order_acquire); }
+
+    /**
+     * @brief publish
+     * @param frame Frame yang akan diterbitkan
+     * @note Hanya boleh dipanggil oleh satu produsen. Tidak pernah menunggu konsumen.
+     */
+    void publish(const MCP2515Frame &frame)
+    {
+        uint64_t pos = _hdr->head.load(std::memory_order_relaxed);
+        Slot &s = _slots[pos & _mask];
+        s.seq.store(2 * pos + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        s.frame = frame;
+        s.seq.store(2 * pos + 2, std::memory_order_release);
+        _hdr->head.store(pos + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief read
+     * @param pos Posisi yang akan dibaca
+     * @param frame Frame untuk menyimpan hasil
+     * @return true jika slot masih berisi frame pada posisi tersebut (belum ditimpa)
+     */
+    bool read(uint64_t pos, MCP2515Frame &frame) const
+    {
+        const Slot &s = _slots[pos & _mask];
+        uint64_t seq = s.seq.load(std::memory_order_acquire);
+        if (seq != 2 * pos + 2)
+            return false;
+        frame = s.frame;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return s.seq.load(std::memory_order_relaxed) == seq;
+    }
+};
+
+/**
+ * @brief MCP2515ShmReader
+ * @note Kursor baca milik satu konsumen. Mulai dari frame terbaru saat dibuat.
+ */
+class MCP2515ShmReader
+{
+private:
+    const MCP2515ShmRing &_ring;
+    uint64_t _pos;
+    uint64_t _lost = 0;
+
+public:
+    MCP2515ShmReader(const MCP2515ShmRing &ring) : _ring(ring), _pos(ring.head()) {}
+
+    /**
+     * @brief next
+     * @param frame Frame untuk menyimpan hasil
+     * @return true jika ada frame baru
+     */
+    bool next(MCP2515Frame &frame)
+    {
+        for (;;)
+        {
+            uint64_t head = _ring.head();
+            if (_pos == head)
+                return false;
+            if (head - _pos > _ring.capacity())
+            {
+                _lost += head - _pos - _ring.capacity();
+                _pos = head - _ring.capacity();
+            }
+            if (_ring.read(_pos++, frame))
+                return true;
+            _lost++; // slot sudah ditimpa saat dibaca
+        }
+    }
+
+    uint64_t lost(void) const { return _lost; }
+};
+
+/**
+ * @brief mcp2515OpenGpioIrq
+ * @param chip Path gpiochip (mis. "/dev/gpiochip0")
+ * @param line Nomor line GPIO yang terhubung ke pin INT MCP2515
+ * @return File descriptor event (non-blocking) atau -1 jika gagal
+ * @note Memakai GPIO character device (uAPI v1) dengan event tepi turun.
+ */
+inline int mcp2515OpenGpioIrq(const char *chip, uint32_t line)
+{
+    struct gpioevent_request req;
+    int cfd = open(chip, O_RDONLY | O_CLOEXEC);
+    if (cfd < 0)
+        return -1;
+    memset(&req, 0, sizeof(req));
+    req.lineoffset = line;
+    req.handleflags = GPIOHANDLE_REQUEST_INPUT;
+    req.eventflags = GPIOEVENT_REQUEST_FALLING_EDGE;
+    strncpy(req.consumer_label, "mcp2515", sizeof(req.consumer_label) - 1);
+    int res = ioctl(cfd, GPIO_GET_LINEEVENT_IOCTL, &req);
+    close(cfd);
+    if (res < 0)
+        return -1;
+    fcntl(req.fd, F_SETFL, fcntl(req.fd, F_GETFL) | O_NONBLOCK);
+    return req.fd;
+}
+
+/**
+ * @brief MCP2515LinuxDaemon
+ * @tparam DRIVER Tipe driver, mis. MCP2515Base<MCP2515LinuxSPI>
+ * @note irqFd boleh berupa fd dari mcp2515OpenGpioIrq() atau eventfd (simulasi). Keduanya
+ * dikosongkan dengan read() setiap kali aktif.
+ */
+template <class DRIVER>
+class MCP2515LinuxDaemon
+{
+private:
+    DRIVER &_can;
+    MCP2515ShmRing &_ring;
+    int _irqFd;
+    int _epfd = -1;
+    int _stopFd = -1;
+    volatile bool _running = false;
+
+    uint64_t _wakeups = 0;
+    uint64_t _spurious = 0; // INT aktif tetapi tidak ada frame
+    uint64_t _frames = 0;
+
+    void _drainFd(int fd)
+    {
+        uint8_t buf[256];
+        while (read(fd, buf, sizeof(buf)) > 0)
+            ;
+    }
+
+public:
+    MCP2515LinuxDaemon(DRIVER &can, MCP2515ShmRing &ring, int irqFd) : _can(can), _ring(ring), _irqFd(irqFd) {}
+    ~MCP2515LinuxDaemon() { end(); }
+
+    /**
+     * @brief begin
+     * @return true jika epoll berhasil disiapkan
+     */
+    bool begin(void)
+    {
+        struct epoll_event ev;
+        _epfd = epoll_create1(EPOLL_CLOEXEC);
+        _stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (_epfd < 0 || _stopFd < 0)
+            return false;
+        fcntl(_irqFd, F_SETFL, fcntl(_irqFd, F_GETFL) | O_NONBLOCK);
+
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.fd = _irqFd;
+        if (epoll_ctl(_epfd, EPOLL_CTL_ADD, _irqFd, &ev) < 0)
+            return false;
+        ev.data.fd = _stopFd;
+        if (epoll_ctl(_epfd, EPOLL_CTL_ADD, _stopFd, &ev) < 0)
+            return false;
+        return true;
+    }
+
+    void end(void)
+    {
+        if (_epfd >= 0)
+            close(_epfd);
+        if (_stopFd >= 0)
+            close(_stopFd);
+        _epfd = _stopFd = -1;
+    }
+
+    /**
+     * @brief drain
+     * @return Jumlah frame yang diterbitkan
+     * @note Membaca RX buffer sampai kosong. INT MCP2515 aktif-rendah dan baru membuat tepi turun
+     * baru setelah semua flag RX bersih, jadi buffer harus dikuras habis setiap kali.
+     */
+    uint32_t drain(void)
+    {
+        MCP2515Frame frame;
+        uint32_t n = 0;
+        while (_can.readFrame(frame) == MCP2515Def::RSPN_OK)
+        {
+            _ring.publish(frame);
+            n++;
+        }
+        _frames += n;
+        return n;
+    }
+
+    /**
+     * @brief poll
+     * @param timeoutMs Batas waktu epoll_wait (-1 = tunggu terus)
+     * @return Jumlah frame yang diterbitkan, atau -1 jika stop() dipanggil / epoll gagal
+     */
+    int poll(int timeoutMs)
+    {
+        struct epoll_event ev[2];
+        int n = epoll_wait(_epfd, ev, 2, timeoutMs);
+        uint32_t frames = 0;
+
+        if (n < 0)
+            return (errno == EINTR) ? 0 : -1;
+        for (int i = 0; i < n; i++)
+        {
+            if (ev[i].data.fd == _stopFd)
+            {
+                _drainFd(_stopFd);
+                _running = false;
+                return -1;
+            }
+            _drainFd(_irqFd);
+            _wakeups++;
+            frames = drain();
+            if (!frames)
+                _spurious++;
+        }
+        return frames;
+    }
+
+    /**
+     * @brief run
+     * @note Loop utama daemon sampai stop() dipanggil.
+     */
+    void run(void)
+    {
+        _running = true;
+        drain(); // INT mungkin sudah aktif sebelum epoll siap
+        while (_running && poll(-1) >= 0)
+            ;
+    }
+
+    /**
+     * @brief stop
+     * @note Aman dipanggil dari thread lain atau signal handler.
+     */
+    void stop(void)
+    {
+        uint64_t one = 1;
+        _running = false;
+        if (write(_stopFd, &one, sizeof(one)) < 0)
+            return;
+    }
+
+    uint64_t wakeups(void) const { return _wakeups; }
+    uint64_t spuriousWakeups(void) const { return _spurious; }
+    uint64_t frames(void) const { return _frames; }
+};
+
+#endif // __linux__ && !ARDUINO
+
+#endif
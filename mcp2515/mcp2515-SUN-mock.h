@@ -0,0 +1,488 @@
+/**
+ * @file mcp2515-SUN-mock.h
+ * @brief Model MCP2515 di memori untuk menjalankan driver tanpa hardware
+ * @note MCP2515MockChip meniru register file, perintah SPI (RESET, READ, WRITE, BIT MODIFY,
+ * READ STATUS, READ RX BUFFER, LOAD TX BUFFER, RTS), perpindahan mode, dan buffer TX/RX.
+ * @note Waktu bersifat virtual: setiap byte SPI menambah waktu sebesar spiByteNs, sehingga
+ * pengukuran waktu di driver (micros()) tetap bermakna saat dijalankan dengan mock.
+ * @note Bus opsional (busBitrate != 0): node lain mengirim busFrame terus-menerus dengan lama
+ * frame nyata (bit nominal tanpa stuffing / busBitrate) ditambah busGapUs. Bitrate chip dihitung
+ * dari CNF1..CNF3 dan oscHz; jika berbeda lebih dari 0.5% dari bus, setiap frame menyetel MERRF
+ * alih-alih diterima. Waktu bus hanya maju bersama waktu virtual (transaksi SPI, advanceUs()).
+ * @note MCP2515MockSPI adalah transport yang meneruskan transaksi ke sebuah MCP2515MockChip.
+ */
+
+#ifndef MCP2515_LIB_SUN_MOCK_H
+#define MCP2515_LIB_SUN_MOCK_H
+
+#include <stdint.h>
+#include <string.h>
+
+class MCP2515MockChip
+{
+public:
+    /**
+     * @brief Frame
+     * @note Format ID sama dengan readData(): bit 31 = extended, bit 30 = remote request.
+     */
+    struct Frame
+    {
+        uint32_t id;
+        uint8_t len;
+        uint8_t data[8];
+    };
+
+    typedef void (*TxHook)(void *ctx, const Frame &frame);
+    typedef void (*IntHook)(void *ctx);
+
+    uint8_t reg[128];         // register file
+    uint64_t nowNs = 0;       // waktu virtual
+    uint32_t spiByteNs = 800; // lama satu byte SPI (10 MHz)
+    uint32_t transactions = 0;
+    uint32_t bytes = 0;
+    bool txAutoComplete = true; // false: pesan tetap pending (bus macet) sampai completeTx()
+    uint32_t sentCount = 0;
+    uint32_t rxOverflow = 0;
+    Frame lastSent;
+    TxHook txHook = 0;
+    void *txHookCtx = 0;
+    IntHook intHook = 0; // dipanggil saat pin INT berubah menjadi aktif
+    void *intHookCtx = 0;
+    uint32_t oscHz = 16000000; // kristal chip, untuk menghitung bitrate dari CNF1..CNF3
+    uint32_t busBitrate = 0;   // bitrate bus (bit/detik), 0 = tidak ada trafik bus
+    uint32_t busGapUs = 0;     // jeda antar frame di bus
+    Frame busFrame = {0x123, 8, {0, 1, 2, 3, 4, 5, 6, 7}}; // frame yang dikirim node lain
+    uint32_t busFrames = 0;    // frame yang selesai di bus
+    uint32_t busErrors = 0;    // frame yang terbaca sebagai error karena bitrate berbeda
+
+    MCP2515MockChip() { reset(); }
+
+    /**
+     * @brief reset
+     * @note Mengembalikan chip ke kondisi setelah power-on (Configuration Mode).
+     */
+    void reset(void)
+    {
+        memset(reg, 0, sizeof(reg));
+        _setCtrl(0x87);
+        reg[0x0E] = 0x80;
+        _intWasActive = false;
+    }
+
+    uint8_t mode(void) const { return reg[0x0E] & 0xE0; }
+    bool intActive(void) const { return (reg[0x2B] & reg[0x2C]) != 0; }
+    void advanceUs(uint32_t us)
+    {
+        nowNs += (uint64_t)us * 1000;
+        _busStep();
+    }
+    uint32_t micros(void) const { return (uint32_t)(nowNs / 1000); }
+    uint32_t millis(void) const { return (uint32_t)(nowNs / 1000000); }
+
+    /**
+     * @brief bitrate
+     * @return Bitrate chip (bit/detik) dari CNF1..CNF3 dan oscHz
+     */
+    uint32_t bitrate(void) const
+    {
+        uint32_t brp = (reg[0x2A] & 0x3F) + 1;
+        uint32_t ps1 = ((reg[0x29] >> 3) & 0x07) + 1, prop = (reg[0x29] & 0x07) + 1;
+        uint32_t ps2 = (reg[0x29] & 0x80) ? (reg[0x28] & 0x07) + 1 : (ps1 > 2 ? ps1 : 2);
+        return oscHz / (2 * brp * (1 + prop + ps1 + ps2));
+    }
+
+    /**
+     * @brief frameUs
+     * @param frame Frame di bus
+     * @param bps Bitrate bus
+     * @return Lama frame (bit nominal tanpa stuffing, termasuk EOF dan IFS)
+     */
+    static uint32_t frameUs(const Frame &frame, uint32_t bps)
+    {
+        uint32_t bits = ((frame.id & 0x80000000) ? 67 : 47) +
+                        ((frame.id & 0x40000000) ? 0 : 8 * (frame.len > 8 ? 8 : frame.len));
+        return (uint32_t)((uint64_t)bits * 1000000 / bps);
+    }
+
+    /**
+     * @brief receive
+     * @param frame Frame yang datang dari bus
+     * @return true jika frame masuk ke RX buffer
+     * @note Filter/mask tidak dimodelkan. Pada Sleep Mode dengan WAKIE aktif, frame ini
+     * membangunkan chip ke Listen-Only Mode tetapi tidak ikut diterima (sesuai datasheet).
+     */
+    bool receive(const Frame &frame)
+    {
+        uint8_t m = mode();
+        if (m == 0x20)
+        {
+            if (reg[0x2B] & 0x40)
+            {
+                reg[0x2C] |= 0x40;
+                _wake();
+            }
+            _updateInt();
+            return false;
+        }
+        if (m == 0x80)
+            return false;
+
+        uint8_t base;
+        if (!(reg[0x2C] & 0x01))
+            base = 0x60;
+        else if (!(reg[0x2C] & 0x02))
+            base = 0x70;
+        else
+        {
+            rxOverflow++;
+            reg[0x2D] |= 0x40; // EFLG.RX0OVR
+            return false;
+        }
+        uint8_t id[4], len = frame.len > 8 ? 8 : frame.len;
+        _encode(id, frame.id);
+        if (frame.id & 0x40000000)
+        {
+            if (frame.id & 0x80000000)
+                len |= 0x40;   // RTR di DLC untuk extended
+            else
+                id[1] |= 0x10; // SRR untuk standard
+        }
+        reg[base] = (reg[base] & ~0x08) | ((frame.id & 0x40000000) && !(frame.id & 0x80000000) ? 0x08 : 0);
+        memcpy(&reg[base + 1], id, 4);
+        reg[base + 5] = len;
+        memcpy(&reg[base + 6], frame.data, 8);
+        reg[0x2C] |= (base == 0x60) ? 0x01 : 0x02;
+        _updateInt();
+        return true;
+    }
+
+    /**
+     * @brief completeTx
+     * @param n Nomor TX buffer (0..2)
+     * @note Menyelesaikan pengiriman pesan yang pending (dipakai saat txAutoComplete = false).
+     */
+    void completeTx(uint8_t n)
+    {
+        uint8_t ctrl = 0x30 + n * 0x10;
+        if (!(reg[ctrl] & 0x08))
+            return;
+        Frame f;
+        _decode(&reg[ctrl + 1], &f.id);
+        f.len = reg[ctrl + 5] & 0x0F;
+        if (f.len > 8)
+            f.len = 8;
+        if (reg[ctrl + 5] & 0x40)
+            f.id |= 0x40000000;
+        memcpy(f.data, &reg[ctrl + 6], 8);
+        reg[ctrl] &= ~0x08;
+        reg[0x2C] |= (0x04 << n);
+        lastSent = f;
+        sentCount++;
+        if (mode() == 0x40) // loopback
+            receive(f);
+        if (txHook)
+            txHook(txHookCtx, f);
+        _updateInt();
+    }
+
+    /**
+     * @brief failTx
+     * @param n Nomor TX buffer (0..2)
+     * @note Meniru kalah arbitrasi. Pada One-Shot Mode TXREQ langsung dibersihkan.
+     */
+    void failTx(uint8_t n)
+    {
+        uint8_t ctrl = 0x30 + n * 0x10;
+        if (!(reg[ctrl] & 0x08))
+            return;
+        reg[ctrl] |= 0x20; // MLOA
+        if (reg[0x0F] & 0x08)
+            reg[ctrl] &= ~0x08;
+    }
+
+    // ---- antarmuka SPI (dipanggil oleh MCP2515MockSPI) ----
+    void select(void)
+    {
+        _busStep();
+        _phase = 0;
+        transactions++;
+    }
+
+    uint8_t exchange(uint8_t mosi)
+    {
+        uint8_t miso = 0xFF;
+        bytes++;
+        nowNs += spiByteNs;
+        if (_phase == 0)
+        {
+            _cmd = mosi;
+            _phase = 1;
+            if (mosi == 0xC0)
+                reset();
+            else if ((mosi & 0xF8) == 0x40) // LOAD TX BUFFER
+            {
+                static const uint8_t start[6] = {0x31, 0x36, 0x41, 0x46, 0x51, 0x56};
+                _addr = start[(mosi & 0x07) > 5 ? 5 : (mosi & 0x07)];
+                _cmd = 0x02;
+                _phase = 2;
+            }
+            else if ((mosi & 0xF9) == 0x90) // READ RX BUFFER
+            {
+                _addr = ((mosi & 0x04) ? 0x71 : 0x61) + ((mosi & 0x02) ? 5 : 0);
+                _rxRead = (mosi & 0x04) ? 0x02 : 0x01;
+                _cmd = 0x03;
+                _phase = 2;
+            }
+            else if ((mosi & 0xF8) == 0x80) // RTS
+            {
+                for (uint8_t n = 0; n < 3; n++)
+                    if (mosi & (1 << n))
+                        _writeReg(0x30 + n * 0x10, reg[0x30 + n * 0x10] | 0x08);
+            }
+            return miso;
+        }
+        switch (_cmd)
+        {
+        case 0x03: // READ
+            if (_phase == 1)
+            {
+                _addr = mosi;
+                _phase = 2;
+            }
+            else
+                miso = reg[_addr++ & 0x7F];
+            break;
+        case 0x02: // WRITE
+            if (_phase == 1)
+            {
+                _addr = mosi;
+                _phase = 2;
+            }
+            else
+                _writeReg(_addr++ & 0x7F, mosi);
+            break;
+        case 0x05: // BIT MODIFY
+            if (_phase == 1)
+                _addr = mosi;
+            else if (_phase == 2)
+                _mask = mosi;
+            else if (_phase == 3)
+                _writeReg(_addr, (reg[_addr] & ~_mask) | (mosi & _mask));
+            _phase++;
+            break;
+        case 0xA0: // READ STATUS
+            miso = _status();
+            break;
+        case 0xB0: // RX STATUS
+            miso = (reg[0x2C] & 0x03) << 6;
+            break;
+        default:
+            break;
+        }
+        return miso;
+    }
+
+    void unselect(void)
+    {
+        if (_rxRead)
+        {
+            reg[0x2C] &= ~_rxRead; // READ RX BUFFER membersihkan RXnIF saat CS naik
+            _rxRead = 0;
+            _updateInt();
+        }
+    }
+
+private:
+    uint8_t _cmd = 0, _phase = 0, _addr = 0, _mask = 0, _rxRead = 0;
+    bool _intWasActive = false;
+    uint32_t _busRate = 0;
+    uint64_t _busNextNs = 0; // akhir frame bus berikutnya
+
+    void _busStep(void)
+    {
+        if (busBitrate != _busRate) // bus baru dinyalakan atau bitrate diganti
+        {
+            _busRate = busBitrate;
+            if (_busRate)
+                _busNextNs = nowNs + (uint64_t)frameUs(busFrame, _busRate) * 1000;
+        }
+        while (_busRate && nowNs >= _busNextNs)
+        {
+            _busNextNs += ((uint64_t)frameUs(busFrame, _busRate) + busGapUs) * 1000;
+            busFrames++;
+            uint8_t m = mode();
+            if (m == 0x80 || m == 0x40) // Configuration dan Loopback Mode tidak melihat bus
+                continue;
+            uint32_t own = bitrate();
+            uint32_t diff = own > _busRate ? own - _busRate : _busRate - own;
+            if (m == 0x20 || diff * 200 <= _busRate) // aktivitas bus tetap membangunkan Sleep Mode
+                receive(busFrame);
+            else
+            {
+                busErrors++;
+                reg[0x2C] |= 0x80; // MERRF
+                _updateInt();
+            }
+        }
+    }
+
+    void _setCtrl(uint8_t v)
+    {
+        for (uint8_t a = 0x0F; a < 0x80; a += 0x10)
+            reg[a] = v;
+    }
+
+    void _setMode(uint8_t m)
+    {
+        for (uint8_t a = 0x0E; a < 0x80; a += 0x10)
+            reg[a] = (reg[a] & ~0xE0) | m;
+        if (m == 0x00 || m == 0x40) // pesan pending dikirim saat keluar dari Configuration Mode
+            for (uint8_t n = 0; n < 3; n++)
+                if (txAutoComplete && (reg[0x30 + n * 0x10] & 0x08))
+                    completeTx(n);
+    }
+
+    void _wake(void)
+    {
+        _setMode(0x60); // bangun ke Listen-Only Mode
+    }
+
+    static bool _configOnly(uint8_t a)
+    {
+        return (a <= 0x1B && a != 0x0C && a != 0x0D && a != 0x0E && a != 0x0F) || (a >= 0x20 && a <= 0x2A);
+    }
+
+    void _writeReg(uint8_t a, uint8_t v)
+    {
+        if ((a & 0x0F) == 0x0E || a == 0x1C || a == 0x1D)
+            return; // CANSTAT, TEC, REC read-only
+        if ((a & 0x0F) == 0x0F)
+        {
+            uint8_t old = reg[0x0F];
+            _setCtrl(v);
+            if ((v & 0x10) && !(old & 0x10)) // ABAT
+                for (uint8_t n = 0; n < 3; n++)
+                    _abort(n);
+            if ((v & 0xE0) != mode() && mode() != 0x20) // dari Sleep hanya bisa bangun lewat WAKIF/bus
+                _setMode(v & 0xE0);
+            return;
+        }
+        if (_configOnly(a) && mode() != 0x80)
+            return;
+        if (a == 0x30 || a == 0x40 || a == 0x50)
+        {
+            uint8_t n = (a - 0x30) >> 4;
+            uint8_t old = reg[a];
+            reg[a] = (old & 0x70) | (v & 0x0B);
+            if ((v & 0x08) && !(old & 0x08))
+            {
+                reg[a] &= ~0x70; // ABTF, MLOA, TXERR dibersihkan saat TXREQ diset
+                if (txAutoComplete && (mode() == 0x00 || mode() == 0x40))
+                    completeTx(n);
+            }
+            return; // TXREQ dibersihkan per buffer tidak menyetel ABTF (hanya ABAT)
+        }
+        if (a == 0x2C && mode() == 0x20 && (v & 0x40) && !(reg[a] & 0x40) && (reg[0x2B] & 0x40))
+        {
+            reg[a] = v;
+            _wake();
+            _updateInt();
+            return;
+        }
+        reg[a] = v;
+        if (a == 0x2B || a == 0x2C)
+            _updateInt();
+    }
+
+    void _abort(uint8_t n)
+    {
+        uint8_t a = 0x30 + n * 0x10;
+        if (reg[a] & 0x08)
+            reg[a] = (reg[a] & ~0x08) | 0x40;
+    }
+
+    uint8_t _status(void) const
+    {
+        uint8_t f = reg[0x2C];
+        return (f & 0x03) |
+               ((reg[0x30] & 0x08) ? 0x04 : 0) | ((f & 0x04) ? 0x08 : 0) |
+               ((reg[0x40] & 0x08) ? 0x10 : 0) | ((f & 0x08) ? 0x20 : 0) |
+               ((reg[0x50] & 0x08) ? 0x40 : 0) | ((f & 0x10) ? 0x80 : 0);
+    }
+
+    void _updateInt(void)
+    {
+        bool active = intActive();
+        if (active && !_intWasActive && intHook)
+            intHook(intHookCtx);
+        _intWasActive = active;
+    }
+
+    static void _encode(uint8_t out[4], uint32_t id)
+    {
+        if (id & 0x80000000)
+        {
+            uint32_t e = id & 0x1FFFFFFF;
+            out[0] = (uint8_t)(e >> 21);
+            out[1] = (uint8_t)(((e >> 13) & 0xE0) | 0x08 | ((e >> 16) & 0x03));
+            out[2] = (uint8_t)(e >> 8);
+            out[3] = (uint8_t)e;
+        }
+        else
+        {
+            uint32_t s = id & 0x7FF;
+            out[0] = (uint8_t)(s >> 3);
+            out[1] = (uint8_t)((s & 0x07) << 5);
+            out[2] = out[3] = 0;
+        }
+    }
+
+    static void _decode(const uint8_t in[4], uint32_t *id)
+    {
+        uint32_t v = ((uint32_t)in[0] << 3) | (in[1] >> 5);
+        if (in[1] & 0x08)
+        {
+            v = (v << 2) | (in[1] & 0x03);
+            v = (v << 8) | in[2];
+            v = (v << 8) | in[3];
+            v |= 0x80000000;
+        }
+        *id = v;
+    }
+};
+
+/**
+ * @brief MCP2515MockSPI
+ * @note Transport yang menghubungkan MCP2515Base ke MCP2515MockChip.
+ */
+class MCP2515MockSPI
+{
+private:
+    MCP2515MockChip *_chip;
+
+public:
+    MCP2515MockSPI(MCP2515MockChip &chip) : _chip(&chip) {}
+
+    inline void begin(void) {}
+
+    inline void transfer(const uint8_t *cmd, uint8_t cmdLen, const uint8_t *tx, uint8_t *rx, uint8_t n)
+    {
+        uint8_t i, v;
+        _chip->select();
+        for (i = 0; i < cmdLen; i++)
+            _chip->exchange(cmd[i]);
+        for (i = 0; i < n; i++)
+        {
+            v = _chip->exchange(tx ? tx[i] : 0x00);
+            if (rx)
+                rx[i] = v;
+        }
+        _chip->unselect();
+    }
+
+    inline uint32_t millis(void) { return _chip->millis(); }
+    inline uint32_t micros(void) { return _chip->micros(); }
+    MCP2515MockChip &chip(void) { return *_chip; }
+};
+
+#endif
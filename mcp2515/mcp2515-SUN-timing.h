@@ -0,0 +1,114 @@
+/**
+ * @file mcp2515-SUN-timing.h
+ * @brief Penghitung bit timing (CNF1/CNF2/CNF3) MCP2515 untuk kristal dan bitrate apa pun
+ * @note mcp2515SolveTiming() mencari BRP dan pembagian segmen (PropSeg, PS1, PS2) dengan error
+ * bitrate terkecil, lalu titik sampel terdekat, lalu jumlah TQ terbanyak. Batasan MCP2515:
+ * 5..25 TQ per bit, PropSeg 1..8, PS1 1..8, PS2 2..8, PropSeg + PS1 >= PS2, SJW <= PS1, SJW < PS2.
+ * @note Pada C++14 fungsi ini constexpr, dan MCP2515Timing<> menolak konfigurasi yang tidak
+ * mungkin saat kompilasi. Pada C++11 fungsi tetap bisa dipakai saat runtime (cek .valid).
+ * @note Contoh:
+ *   can.initialize(MCP2515::REQ_NORMAL, MCP2515::IMOD_ANY, MCP2515Timing<12000000, 500000, 800>::get());
+ */
+
+#ifndef MCP2515_LIB_SUN_TIMING_H
+#define MCP2515_LIB_SUN_TIMING_H
+
+#include "mcp2515-SUN.h"
+
+#if __cplusplus >= 201402L
+#define MCP2515_CONSTEXPR14 constexpr
+#else
+#define MCP2515_CONSTEXPR14 inline
+#endif
+
+/**
+ * @brief mcp2515SolveTiming
+ * @param oscHz Frekuensi kristal MCP2515 dalam Hz
+ * @param bitrate Bitrate yang diinginkan (bit/detik)
+ * @param samplePermille Titik sampel yang diinginkan (per mil, mis. 875 = 87.5%)
+ * @param sjw Synchronization Jump Width (1..4 TQ)
+ * @param maxErrPpm Error bitrate maksimum yang diterima (ppm)
+ * @return Nilai CNF1/CNF2/CNF3 dan hasil sebenarnya; valid == false jika tidak ada solusi
+ */
+MCP2515_CONSTEXPR14 MCP2515BitTiming mcp2515SolveTiming(uint32_t oscHz, uint32_t bitrate, uint16_t samplePermille = 875,
+                                                        uint8_t sjw = 1, uint32_t maxErrPpm = 1000)
+{
+    MCP2515BitTiming best = {0, 0, 0, false, 0, 0};
+    uint32_t bestErr = 0xFFFFFFFF;
+    uint16_t bestSpErr = 0xFFFF;
+    uint8_t bestN = 0;
+
+    if (oscHz == 0 || bitrate == 0 || sjw < 1 || sjw > 4 || samplePermille >= 1000)
+        return best;
+
+    for (uint8_t brp = 1; brp <= 64; brp++)
+    {
+        for (uint8_t n = 5; n <= 25; n++)
+        {
+            uint64_t div = 2ULL * brp * n;
+            uint32_t actual = (uint32_t)((oscHz + div / 2) / div);
+            uint64_t diff = (actual > bitrate) ? actual - bitrate : bitrate - actual;
+            uint32_t err = (uint32_t)(diff * 1000000ULL / bitrate);
+            if (err > maxErrPpm || err > bestErr)
+                continue;
+
+            for (uint8_t ps2 = 2; ps2 <= 8; ps2++)
+            {
+                uint8_t tseg1 = n - 1 - ps2; // PropSeg + PS1
+                if (ps2 <= sjw || tseg1 < 2 || tseg1 > 16 || tseg1 < ps2)
+                    continue;
+                uint8_t ps1 = tseg1 / 2;
+                if (ps1 < sjw)
+                    ps1 = sjw;
+                uint8_t prop = tseg1 - ps1;
+                if (prop > 8)
+                {
+                    prop = 8;
+                    ps1 = tseg1 - 8;
+                }
+                if (prop < 1 || ps1 < 1 || ps1 > 8 || ps1 < sjw)
+                    continue;
+
+                uint16_t sp = (uint16_t)((1 + tseg1) * 1000U / n);
+                uint16_t spErr = (sp > samplePermille) ? sp - samplePermille : samplePermille - sp;
+                if (err < bestErr || spErr < bestSpErr || (spErr == bestSpErr && n > bestN))
+                {
+                    bestErr = err;
+                    bestSpErr = spErr;
+                    bestN = n;
+                    best.cnf1 = (uint8_t)(((sjw - 1) << 6) | (brp - 1));
+                    best.cnf2 = (uint8_t)(0x80 | ((ps1 - 1) << 3) | (prop - 1)); // BTLMODE: PS2 dari CNF3
+                    best.cnf3 = (uint8_t)(ps2 - 1);
+                    best.valid = true;
+                    best.bitrate = actual;
+                    best.samplePermille = sp;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+#if __cplusplus >= 201402L
+/**
+ * @brief MCP2515Timing
+ * @tparam OSC Frekuensi kristal MCP2515 dalam Hz
+ * @tparam BITRATE Bitrate yang diinginkan (bit/detik)
+ * @tparam SP Titik sampel (per mil)
+ * @tparam SJW Synchronization Jump Width (1..4 TQ)
+ * @tparam MAXERRPPM Error bitrate maksimum (ppm)
+ * @note Kompilasi gagal jika konfigurasi tidak bisa dicapai.
+ */
+template <uint32_t OSC, uint32_t BITRATE, uint16_t SP = 875, uint8_t SJW = 1, uint32_t MAXERRPPM = 1000>
+struct MCP2515Timing
+{
+    static_assert(SJW >= 1 && SJW <= 4, "SJW harus 1..4 TQ");
+    static_assert(SP > 0 && SP < 1000, "Titik sampel harus dalam per mil (1..999)");
+    static_assert(mcp2515SolveTiming(OSC, BITRATE, SP, SJW, MAXERRPPM).valid,
+                  "Bitrate tidak bisa dicapai dengan kristal ini (BRP 1..64, 5..25 TQ per bit)");
+
+    static constexpr MCP2515BitTiming get(void) { return mcp2515SolveTiming(OSC, BITRATE, SP, SJW, MAXERRPPM); }
+};
+#endif
+
+#endif
@@ -0,0 +1,236 @@
+/**
+ * @file mcp2515-SUN-transport.h
+ * @brief Policy transport SPI untuk MCP2515Base
+ * @note Setiap transport menyediakan:
+ * @note - begin()                            : inisialisasi bus dan pin CS
+ * @note - transfer(cmd, cmdLen, tx, rx, n)   : satu transaksi SPI (CS aktif selama transaksi).
+ *         Kirim cmdLen byte perintah, lalu n byte data dari tx (0x00 jika tx NULL),
+ *         byte yang diterima selama fase data disimpan ke rx (diabaikan jika rx NULL).
+ * @note - millis(), micros()                 : sumber waktu
+ * @note Transport yang tersedia: MCP2515ArduinoSPI, MCP2515Esp32SPI (register langsung),
+ * MCP2515LinuxSPI (spidev). Mock chip untuk pengujian ada di mcp2515-SUN-mock.h.
+ */
+
+#ifndef MCP2515_LIB_SUN_TRANSPORT_H
+#define MCP2515_LIB_SUN_TRANSPORT_H
+
+#include <stdint.h>
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#include <SPI.h>
+
+/**
+ * @brief MCP2515ArduinoSPI
+ * @note Transport default memakai SPIClass dan digitalWrite, sama seperti versi non-template.
+ */
+class MCP2515ArduinoSPI
+{
+private:
+    SPIClass *_spi;
+    SPISettings _spiSettings;
+    int8_t _cs; // Chip Select pin number
+
+    inline void __spi_unSelect() { digitalWrite(_cs, HIGH); }
+    inline void __spi_select() { digitalWrite(_cs, LOW); }
+
+public:
+    MCP2515ArduinoSPI(uint8_t CS_PIN, SPIClass *spi = &SPI, uint32_t clock = 10000000)
+        : _spi(spi),
+          _spiSettings(SPISettings(clock, MSBFIRST, SPI_MODE0)),
+          _cs(CS_PIN) {}
+
+    inline void begin(void)
+    {
+        pinMode(_cs, OUTPUT);
+        __spi_unSelect();
+        _spi->begin();
+    }
+
+    inline void transfer(const uint8_t *cmd, uint8_t cmdLen, const uint8_t *tx, uint8_t *rx, uint8_t n)
+    {
+        uint8_t i, v;
+        _spi->beginTransaction(_spiSettings);
+        __spi_select();
+        for (i = 0; i < cmdLen; i++)
+            _spi->transfer(cmd[i]);
+        for (i = 0; i < n; i++)
+        {
+            v = _spi->transfer(tx ? tx[i] : 0x00);
+            if (rx)
+                rx[i] = v;
+        }
+        __spi_unSelect();
+        _spi->endTransaction();
+    }
+
+    inline uint32_t millis(void) { return ::millis(); }
+    inline uint32_t micros(void) { return ::micros(); }
+};
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include "esp32-hal-spi.h"
+#include "soc/gpio_reg.h"
+#include "soc/soc.h"
+
+/**
+ * @brief MCP2515Esp32SPI
+ * @note Transport ESP32 yang menulis register GPIO secara langsung untuk CS dan memakai
+ * spiTransferBytesNL (tanpa lock per transaksi). Bus SPI dikunci sekali di begin(),
+ * sehingga bus ini harus dipakai khusus untuk MCP2515.
+ * @note spiTransferBytesNL membaca dan menulis buffer per 32-bit word dan mengirim 0xFF jika data
+ * NULL, jadi perintah dan data disalin ke buffer kerja yang sejajar 4 byte dan diisi 0x00.
+ */
+class MCP2515Esp32SPI
+{
+private:
+    SPIClass *_spi;
+    SPISettings _spiSettings;
+    uint8_t _cs;
+    uint32_t _csMask;
+    uint32_t _scratch[65]; // perintah (maks. 4 byte) + data (maks. 255 byte), sejajar 4 byte
+
+    inline void __spi_unSelect()
+    {
+#ifdef GPIO_OUT1_W1TS_REG
+        if (_cs >= 32)
+        {
+            REG_WRITE(GPIO_OUT1_W1TS_REG, _csMask);
+            return;
+        }
+#endif
+        REG_WRITE(GPIO_OUT_W1TS_REG, _csMask);
+    }
+    inline void __spi_select()
+    {
+#ifdef GPIO_OUT1_W1TC_REG
+        if (_cs >= 32)
+        {
+            REG_WRITE(GPIO_OUT1_W1TC_REG, _csMask);
+            return;
+        }
+#endif
+        REG_WRITE(GPIO_OUT_W1TC_REG, _csMask);
+    }
+
+public:
+    MCP2515Esp32SPI(uint8_t CS_PIN, SPIClass *spi = &SPI, uint32_t clock = 10000000)
+        : _spi(spi),
+          _spiSettings(SPISettings(clock, MSBFIRST, SPI_MODE0)),
+          _cs(CS_PIN),
+          _csMask(1UL << (CS_PIN & 31)) {}
+
+    inline void begin(void)
+    {
+        pinMode(_cs, OUTPUT);
+        __spi_unSelect();
+        _spi->begin();
+        _spi->beginTransaction(_spiSettings); // bus dikunci untuk MCP2515 (tidak pernah dilepas)
+    }
+
+    inline void transfer(const uint8_t *cmd, uint8_t cmdLen, const uint8_t *tx, uint8_t *rx, uint8_t n)
+    {
+        uint8_t *buf = (uint8_t *)_scratch;
+        uint16_t len = cmdLen + n;
+
+        memcpy(buf, cmd, cmdLen);
+        if (tx)
+            memcpy(buf + cmdLen, tx, n);
+        else
+            memset(buf + cmdLen, 0x00, n); // aturan transport: tx NULL = 0x00
+        memset(buf + len, 0x00, (4 - (len & 3)) & 3);
+
+        __spi_select();
+        spiTransferBytesNL(_spi->bus(), buf, rx ? buf : 0, len);
+        __spi_unSelect();
+        if (rx)
+            memcpy(rx, buf + cmdLen, n);
+    }
+
+    inline uint32_t millis(void) { return ::millis(); }
+    inline uint32_t micros(void) { return ::micros(); }
+};
+#endif // ARDUINO_ARCH_ESP32
+
+#elif defined(__linux__)
+#include <fcntl.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/spi/spidev.h>
+
+/**
+ * @brief MCP2515LinuxSPI
+ * @note Transport untuk Linux userspace melalui /dev/spidevB.C. Setiap transaksi adalah satu
+ * ioctl SPI_IOC_MESSAGE (fase perintah + fase data), sehingga CS tetap aktif di antaranya.
+ */
+class MCP2515LinuxSPI
+{
+private:
+    const char *_dev;
+    uint32_t _hz;
+    int _fd = -1;
+
+    static uint64_t _nowUs(void)
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+    }
+
+public:
+    MCP2515LinuxSPI(const char *dev = "/dev/spidev0.0", uint32_t hz = 10000000) : _dev(dev), _hz(hz) {}
+
+    /**
+     * @brief begin
+     * @return true jika spidev berhasil dibuka dan dikonfigurasi
+     */
+    bool begin(void)
+    {
+        uint8_t mode = SPI_MODE_0, bits = 8;
+        if (_fd < 0)
+            _fd = open(_dev, O_RDWR | O_CLOEXEC);
+        if (_fd < 0)
+            return false;
+        if (ioctl(_fd, SPI_IOC_WR_MODE, &mode) < 0 ||
+            ioctl(_fd, SPI_IOC_WR_BITS_PER_WORD, &bits) < 0 ||
+            ioctl(_fd, SPI_IOC_WR_MAX_SPEED_HZ, &_hz) < 0)
+            return false;
+        return true;
+    }
+
+    /**
+     * @brief end
+     * @note Menutup file descriptor spidev.
+     */
+    void end(void)
+    {
+        if (_fd >= 0)
+            close(_fd);
+        _fd = -1;
+    }
+
+    inline void transfer(const uint8_t *cmd, uint8_t cmdLen, const uint8_t *tx, uint8_t *rx, uint8_t n)
+    {
+        struct spi_ioc_transfer xfer[2];
+        memset(xfer, 0, sizeof(xfer));
+        xfer[0].tx_buf = (uintptr_t)cmd;
+        xfer[0].len = cmdLen;
+        xfer[0].speed_hz = _hz;
+        xfer[0].bits_per_word = 8;
+        xfer[1].tx_buf = (uintptr_t)tx;
+        xfer[1].rx_buf = (uintptr_t)rx;
+        xfer[1].len = n;
+        xfer[1].speed_hz = _hz;
+        xfer[1].bits_per_word = 8;
+        ioctl(_fd, SPI_IOC_MESSAGE(n ? 2 : 1), xfer);
+    }
+
+    inline uint32_t millis(void) { return (uint32_t)(_nowUs() / 1000); }
+    inline uint32_t micros(void) { return (uint32_t)_nowUs(); }
+    int fd(void) const { return _fd; }
+};
+#endif // ARDUINO / __linux__
+
+#endif
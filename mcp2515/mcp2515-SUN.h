@@ -14,11 +14,62 @@
 #ifndef MCP2515_LIB_SUN_H
 #define MCP2515_LIB_SUN_H
 
+#if defined(ARDUINO)
 #include <Arduino.h>
 #include <SPI.h>
+#else
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+typedef uint8_t byte;
+#endif
 #include <inttypes.h>
 
-class MCP2515
+#ifndef MCP2515_LOG
+#if defined(ARDUINO)
+#define MCP2515_LOG(msg) Serial.println(msg)
+#else
+#define MCP2515_LOG(msg) ((void)0)
+#endif
+#endif
+
+#ifndef MCP2515_RTR_SLOTS
+#define MCP2515_RTR_SLOTS 4 // jumlah jawaban remote frame yang bisa didaftarkan
+#endif
+
+#include "mcp2515-SUN-transport.h"
+
+/**
+ * @brief MCP2515Frame
+ * @note Satu frame CAN. Format ID sama dengan readData(): bit 31 = extended, bit 30 = remote request.
+ */
+struct MCP2515Frame
+{
+    uint32_t id;        // CAN ID + flag
+    uint8_t len;        // Data Length Code (0..8)
+    uint8_t data[8];    // Data
+    uint32_t timestamp; // micros() saat frame dibaca dari chip
+};
+
+/**
+ * @brief MCP2515BitTiming
+ * @note Nilai register CNF1/CNF2/CNF3. Dihitung oleh mcp2515SolveTiming() (mcp2515-SUN-timing.h).
+ */
+struct MCP2515BitTiming
+{
+    uint8_t cnf1;
+    uint8_t cnf2;
+    uint8_t cnf3;
+    bool valid;              // false jika bitrate tidak bisa dicapai
+    uint32_t bitrate;        // bitrate sebenarnya (bit/detik)
+    uint16_t samplePermille; // titik sampel sebenarnya (per mil)
+};
+
+/**
+ * @brief MCP2515Def
+ * @note Konstanta (kode respon, mode, kecepatan, dan register) yang tidak bergantung pada transport SPI.
+ */
+class MCP2515Def
 {
 public:
     enum RESPONSE
@@ -31,6 +82,7 @@ public:
         RSPN_GETTXBFTIMEOUT = 6,
         RSPN_SENDMSGTIMEOUT = 7,
         RSPN_ALLTXBUSSY = 10,
+        RSPN_DEADLINEMISS = 11,
     };
     enum IDMOD
     {
@@ -93,19 +145,7 @@ public:
         SPD_20MHz_33K3 = 0b000010111111111110000111,
     };
 
-private:
-    SPIClass *_spi;
-    SPISettings _spiSettings;
-    int8_t _cs; // Chip Select pin number
-
-    byte m_nExtFlg; // Identifier Type
-    uint32_t m_nID; // CAN ID
-    byte m_nDlc;    // Data Length Code
-    byte m_nDta[8]; // Data array
-    byte m_nRtr;    // Remote request flag
-    byte canError = 0;
-    OPSMOD _opsModeUse = REQ_NORMAL;
-
+protected:
     enum REGBIT
     {
         BIT_RX0IF = 0x01,
@@ -114,6 +154,7 @@ private:
     enum TAEK
     {
         MCP_TXB_EXIDE_M = 0b00001000,
+        MCP_RXB_SRR_M = 0x10,
         DLC_MASK = 0x0F,
         RTR_MASK = 0x40,
     };
@@ -124,6 +165,9 @@ private:
         CMD_BITMODIF = 0b00000101, // 0x05
         CMD_WRITE = 0b00000010,    // 0x02
         CMD_READ_STATUS = 0xA0,
+        CMD_READ_RX_BUF = 0x90, // 0x90 RXB0SIDH, 0x94 RXB1SIDH
+        CMD_LOAD_TX_BUF = 0x40, // 0x40 TXB0SIDH, 0x42 TXB1SIDH, 0x44 TXB2SIDH
+        CMD_RTS = 0x80,         // 0x81 TXB0, 0x82 TXB1, 0x84 TXB2
     };
     enum MASKB
     {
@@ -138,7 +182,27 @@ private:
     };
     enum TXBTX
     {
+        TXB_ABTF_M = 0x40,
+        TXB_MLOA_M = 0x20,
+        TXB_TXERR_M = 0x10,
         TXB_TXREQ_M = 0x08,
+        TXB_TXP_M = 0x03,
+    };
+    enum CANCTRLBIT
+    {
+        CTRL_REQOP_M = 0xE0,
+        CTRL_ABAT = 0x10, // Abort All Pending Transmissions
+        CTRL_OSM = 0x08,  // One-Shot Mode
+    };
+    enum CNFBIT
+    {
+        CNF3_WAKFIL = 0x40, // filter low-pass pada pin RXCAN untuk wake-up
+    };
+    enum STATBIT
+    {
+        STAT_TX0REQ = 0x04,
+        STAT_TX1REQ = 0x10,
+        STAT_TX2REQ = 0x40,
     };
     enum REGCANT
     {
@@ -163,6 +227,9 @@ private:
         CTR_TXRTSCTRL = 0x0D,
         CTR_RXB0SIDH = 0x61,
         CTR_RXB1SIDH = 0x71,
+        CTR_CNF3 = 0x28,
+        CTR_CNF2 = 0x29,
+        CTR_CNF1 = 0x2A,
     };
     enum CANINTF
     {
@@ -175,11 +242,102 @@ private:
         INTF_WAKIF = 0x40,
         INTF_MERRF = 0x80,
     };
+};
+
+/**
+ * @brief MCP2515Base
+ * @tparam TRANSPORT Policy transport SPI. Harus menyediakan begin(), transfer(cmd, cmdLen, tx, rx, n),
+ * millis(), dan micros(). Lihat mcp2515-SUN-transport.h.
+ * @note Semua pemanggilan transport di-inline saat kompilasi, sehingga tidak ada biaya virtual call.
+ */
+template <class TRANSPORT>
+class MCP2515Base : public MCP2515Def
+{
+private:
+    TRANSPORT _bus; // Transport SPI (bus transfer, chip select, dan sumber waktu)
+
+    byte m_nExtFlg; // Identifier Type
+    uint32_t m_nID; // CAN ID
+    byte m_nDlc;    // Data Length Code
+    byte m_nDta[8]; // Data array
+    byte m_nRtr;    // Remote request flag
+    byte canError = 0;
+    OPSMOD _opsModeUse = REQ_NORMAL;
+
+    bool _oneShot = false;         // One-Shot Mode (OSM) aktif
+    byte _txArmed = 0;             // bit n = TXBn punya deadline aktif
+    uint32_t _txDeadline[3];       // deadline (micros) per TX buffer
+    uint32_t _deadlineMisses = 0;  // jumlah frame yang dibatalkan karena basi
+    byte _txReserved = 0;          // bit n = TXBn tidak dipakai untuk pengiriman biasa
+    uint32_t _lastInitUs = 0;      // lama initialize() terakhir
+    bool _wakeFilter = false;      // WAKFIL ditulis ke CNF3 oleh initialize()/Reconfig
+    bool _wakeFilterReg = false;   // nilai WAKFIL yang sekarang ada di chip
+    bool _sleeping = false;        // sleep() dipanggil dan chip belum dibangunkan
+
+public:
+    struct RtrStats
+    {
+        uint32_t responses; // jawaban yang dikirim
+        uint32_t restaged;  // jawaban yang harus dimuat ulang ke TXB2 sebelum RTS
+        uint32_t fallback;  // TXB2 sibuk, jawaban lewat TX buffer biasa
+        uint32_t dropped;   // tidak ada TX buffer kosong
+        uint32_t latLastUs; // dari frame remote dibaca sampai RTS
+        uint32_t latMinUs;
+        uint32_t latMaxUs;
+    };
+
+private:
+    struct RtrSlot
+    {
+        uint32_t id;         // ID + flag extended (0 = kosong jika len == 0xFF)
+        byte seq;            // ganjil = sedang diubah (hanya lewat __atomic_*)
+        byte len;            // 0xFF = slot kosong
+        byte data[8];
+    };
+    RtrSlot _rtr[MCP2515_RTR_SLOTS];
+    byte _rtrCount = 0;
+    byte _rtrStaged = 0xFF;   // slot yang isinya ada di TXB2
+    bool _rtrDirty = false;   // isi slot yang di-stage berubah saat TXB2 sibuk
+    int8_t _rtrPin = -1;      // pin MCU yang terhubung ke TX2RTS (-1 = pakai instruksi RTS)
+    RtrStats _rtrStats = {};
+
+public:
+    struct RxStats
+    {
+        uint32_t irqFrames;  // frame yang dibaca setelah INT
+        uint32_t pollFrames; // frame yang dibaca di mode polling
+        uint32_t irqEvents;  // INT yang dilayani
+        uint32_t spuriousIrq; // INT tanpa frame
+        uint32_t pollCalls;  // panggilan rxService() di mode polling
+        uint32_t emptyPolls; // panggilan polling tanpa frame (SPI terbuang)
+        uint32_t toPoll;     // perpindahan IRQ -> polling
+        uint32_t toIrq;      // perpindahan polling -> IRQ
+        uint32_t irqBusyUs;  // waktu CPU di rxService() mode IRQ
+        uint32_t pollBusyUs; // waktu CPU di rxService() mode polling
+        uint32_t rateFps;    // laju frame pada jendela terakhir
+    };
+
+    struct SleepStats
+    {
+        uint32_t sleeps;       // sleep() yang berhasil
+        uint32_t busWakes;     // bangun karena aktivitas bus (WAKIF dari chip)
+        uint32_t hostWakes;    // dibangunkan oleh wake() tanpa aktivitas bus
+        uint32_t framesAtWake; // frame yang sudah ada di RX buffer saat wake() (diterima di Listen-Only)
+        uint32_t lastWakeUs;   // latensi wake-to-ready terakhir
+        uint32_t maxWakeUs;
+    };
 
-    inline void __spi_unSelect() { digitalWrite(_cs, HIGH); }
-    inline void __spi_select() { digitalWrite(_cs, LOW); }
-    inline uint8_t __spi_readWrite(uint8_t data) { return _spi->transfer(data); }
-    inline uint8_t __spi_read() { return __spi_readWrite(0x00); }
+private:
+    volatile bool _rxIrqPending = true; // frame mungkin sudah ada sebelum INT pertama
+    bool _rxPolling = false;
+    uint32_t _rxHighFps = 2000;  // IRQ -> polling jika laju >= nilai ini
+    uint32_t _rxLowFps = 500;    // polling -> IRQ jika laju <= nilai ini
+    uint32_t _rxWindowUs = 10000;
+    byte _rxBudget = 8;
+    uint32_t _rxWinStart = 0;
+    uint32_t _rxWinFrames = 0;
+    RxStats _rxStats = {};
+    SleepStats _sleepStats = {};
 
     /**
      * @brief __bitModify
@@ -190,16 +348,9 @@ private:
      */
     inline void __bitModify(const byte address, const byte mask, const byte data)
     {
-        _spi->beginTransaction(_spiSettings);
-        __spi_select();
-        //
-        __spi_readWrite(CMD_BITMODIF); // 0x05 00000101 Perintah BIT MODIFY
-        __spi_readWrite(address);      // 0x0F 00001111 Alamat register CANCTRL (0x0F)
-        __spi_readWrite(mask);         // 0xE0 11100000  Mask: bit yang boleh diubah (REQOP2:0)
-        __spi_readWrite(data);         // 0x80 10000000 Data baru: 0x80 → minta Configuration Mode
-        //
-        __spi_unSelect();
-        _spi->endTransaction();
+        // 0x05 BIT MODIFY, alamat register, mask bit yang boleh diubah, data baru
+        const byte cmd[4] = {CMD_BITMODIF, address, mask, data};
+        _bus.transfer(cmd, 4, 0, 0, 0);
     }
 
     /**
@@ -210,15 +361,9 @@ private:
      */
     byte __readRegister(const byte address)
     {
+        const byte cmd[2] = {CMD_READ, address};
         byte ret;
-        _spi->beginTransaction(_spiSettings);
-        __spi_select();
-        __spi_readWrite(CMD_READ);
-        __spi_readWrite(address);
-        ret = __spi_read();
-        __spi_unSelect();
-        _spi->endTransaction();
-
+        _bus.transfer(cmd, 2, 0, &ret, 1);
         return ret;
     }
 
@@ -232,17 +377,9 @@ private:
      */
     void __readRegisters(const byte address, byte values[], const byte n)
     {
-        byte i;
-        _spi->beginTransaction(_spiSettings);
-        __spi_select();
-        __spi_readWrite(CMD_READ);
-        __spi_readWrite(address);
         // mcp2515 has auto-increment of address-pointer
-        for (i = 0; i < n; i++)
-            values[i] = __spi_read();
-
-        __spi_unSelect();
-        _spi->endTransaction();
+        const byte cmd[2] = {CMD_READ, address};
+        _bus.transfer(cmd, 2, 0, values, n);
     }
 
     /**
@@ -254,13 +391,8 @@ private:
      */
     void __writeRegister(const byte address, const byte value)
     {
-        _spi->beginTransaction(_spiSettings);
-        __spi_select();
-        __spi_readWrite(0x02);
-        __spi_readWrite(address);
-        __spi_readWrite(value);
-        __spi_unSelect();
-        _spi->endTransaction();
+        const byte cmd[3] = {CMD_WRITE, address, value};
+        _bus.transfer(cmd, 3, 0, 0, 0);
     }
 
     /**
@@ -273,17 +405,8 @@ private:
      */
     void __writeRegisters(const byte address, const byte values[], const byte n)
     {
-        byte i;
-        _spi->beginTransaction(_spiSettings);
-        __spi_select();
-        __spi_readWrite(CMD_WRITE);
-        __spi_readWrite(address);
-
-        for (i = 0; i < n; i++)
-            __spi_readWrite(values[i]);
-
-        __spi_unSelect();
-        _spi->endTransaction();
+        const byte cmd[2] = {CMD_WRITE, address};
+        _bus.transfer(cmd, 2, values, 0, n);
     }
 
     /**
@@ -294,7 +417,7 @@ private:
      */
     byte _toRequestMode(const byte newMod)
     {
-        byte startTime = millis();
+        uint32_t startTime = _bus.millis();
 
         // Spam new mode request and wait for the operation  to complete
         while (1)
@@ -306,51 +429,41 @@ private:
             byte statReg = __readRegister(CTR_CANSTAT);
             if ((statReg & 0xE0) == newMod) // We're now in the new mode
                 return RSPN_OK;
-            else if ((byte)(millis() - startTime) > 200) // Wait no more than 200ms for the operation to complete
+            else if ((_bus.millis() - startTime) > 200) // Wait no more than 200ms for the operation to complete
                 return RSPN_FAIL;
         }
     }
 
     /**
      * @brief _exitSleepMode
-     * @param reqMode Mode baru yang akan diminta
+     * @param reqMode Mode baru yang akan diminta (bukan Sleep Mode)
      * @return Kode status dari permintaan mode baru
      * @note Fungsi ini digunakan untuk keluar dari mode tidur (Sleep Mode) pada MCP2515.
      */
     byte _exitSleepMode(const byte reqMode)
     {
         /**
-         * periksa apakah chip sedang dalam "Sleep Mode" melalui Register CANSTAT ambil bit ke 5:7
-         * dan jika mode Baru adalah Sleep Mode (0x20). maka tidak perlu mengaktifkan interrupt wake-up.
-         * Jika chip dalam Sleep Mode dan mode baru bukan Sleep Mode,
-         * maka periksa apakah interrupt wake-up sudah aktif atau belum.
-         * Jika belum aktif, aktifkan interrupt wake-up (WAKIE) pada Register CANINTE
-         * dan Register CANINTF, lalu ubah mode ke mode baru yang diinginkan.
-         * Jika tidak dalam Sleep Mode, langsung ubah mode ke mode baru.
+         * Chip dibangunkan dengan menyetel WAKIF (interrupt wake-up WAKIE harus aktif).
+         * Chip selalu bangun ke Listen-Only Mode, jadi mode baru langsung diminta
+         * tanpa singgah di Listen-Only secara eksplisit.
          */
-        if ((__readRegister(CTR_CANSTAT) & 0xE0) == REQ_SLEEP && reqMode != REQ_SLEEP)
+        byte wakeIntEnabled = (__readRegister(CTR_CANINTE) & INTF_WAKIF);
+        if (!wakeIntEnabled)
         {
-            byte wakeIntEnabled = (__readRegister(CTR_CANINTE) & 0x40);
-            if (!wakeIntEnabled)
-            {
-                __bitModify(CTR_CANINTE, 0x40, 0x40);
-            }
-            __bitModify(CTR_CANINTF, 0x40, 0x40);
+            __bitModify(CTR_CANINTE, INTF_WAKIF, INTF_WAKIF);
+        }
+        __bitModify(CTR_CANINTF, INTF_WAKIF, INTF_WAKIF);
 
-            if (_toRequestMode(REQ_LISTENONLY) != RSPN_OK)
-            {
-                return RSPN_FAIL;
-            }
+        byte res = _toRequestMode(reqMode);
 
-            if (!wakeIntEnabled)
-            {
-                __bitModify(CTR_CANINTE, 0x40, 0);
-            }
+        if (!wakeIntEnabled)
+        {
+            __bitModify(CTR_CANINTE, INTF_WAKIF, 0);
         }
         // Clear wake flag
-        __bitModify(CTR_CANINTF, 0x40, 0);
-
-        return RSPN_OK;
+        __bitModify(CTR_CANINTF, INTF_WAKIF, 0);
+        _sleeping = false;
+        return res;
     }
 
     /**
@@ -364,129 +477,78 @@ private:
         /**
          * menangani kondisi saat MCP2515 sedang dalam Sleep Mode (0x20) dan
          * ingin dipindahkan ke mode lain (bukan Sleep).
-         * Agar transisi itu berhasil, ia mengaktifkan sementara interrupt wake-up,
-         * lalu masuk ke mode baru.
          */
-        if (_exitSleepMode(mode) != RSPN_OK)
+        if ((__readRegister(CTR_CANSTAT) & 0xE0) == REQ_SLEEP && mode != REQ_SLEEP)
         {
-            return RSPN_FAIL;
+            return _exitSleepMode(mode);
         }
-        //
+        // Clear wake flag
+        __bitModify(CTR_CANINTF, INTF_WAKIF, 0);
         return _toRequestMode(mode);
     }
 
     /**
-     * @brief _writeMasknFilter
-     * @param mcp_addr Alamat MCP2515
-     * @param ext Flag ekstensi untuk ID
-     * @param id ID yang akan ditulis
-     * @note Fungsi ini digunakan untuk menulis nilai mask dan filter pada MCP2515.
+     * @brief _writeInitImage
+     * @param timing Nilai CNF1/CNF2/CNF3
+     * @param imod Mode ID untuk RX buffer
+     * @note Semua register konfigurasi disusun di RAM lalu ditulis dengan burst write: blok
+     * RXF0..RXF2 + BFPCTRL + TXRTSCTRL, blok RXF3..RXF5, blok mask + CNF3..CNF1 + CANINTE,
+     * tiga TX buffer, RXB0CTRL, dan RXB1CTRL (8 transaksi SPI, sebelumnya lebih dari 50).
+     * Harus dipanggil di Configuration Mode.
      */
-    void _writeMasknFilter(const byte mcp_addr, const byte ext, const uint32_t id)
+    void _writeInitImage(const MCP2515BitTiming &timing, const byte imod)
     {
-        uint16_t canid;
-        byte tbufdata[4];
-
-        canid = (uint16_t)(id & 0x0FFFF);
+        byte blkA[14], blkB[12], blkC[12];
+        byte rxb0, rxb1, i;
 
-        if (ext == 1)
-        {
-            tbufdata[3] = (byte)(canid & 0xFF);
-            tbufdata[2] = (byte)(canid >> 8);
-            canid = (uint16_t)(id >> 16);
-            tbufdata[1] = (byte)(canid & 0x03);
-            tbufdata[1] += (byte)((canid & 0x1C) << 3);
-            tbufdata[1] |= MCP_TXB_EXIDE_M;
-            tbufdata[0] = (byte)(canid >> 5);
-        }
-        else
+        /* Filter 0 sampai 5 = 0, filter genap extended, filter ganjil standar */
+        for (i = 0; i < 3; i++)
         {
-            tbufdata[3] = (byte)(canid & 0xFF);
-            tbufdata[2] = (byte)(canid >> 8);
-            canid = (uint16_t)(id >> 16);
-            tbufdata[1] = (byte)((canid & 0x07) << 5);
-            tbufdata[0] = (byte)(canid >> 3);
+            _encodeID(blkA + i * 4, (i & 1) ? 0 : 1, 0);
+            _encodeID(blkB + i * 4, (i & 1) ? 1 : 0, 0);
         }
+        blkA[12] = MASK_BxBFS | MASK_BxBFE;      // BFPCTRL: BF pin sebagai GPO
+        blkA[13] = (_rtrPin >= 0) ? 0x04 : 0x00; // TXRTSCTRL: RTS pin sebagai GPI kecuali TX2RTS dipakai
 
-        __writeRegisters(mcp_addr, tbufdata, 4);
-    }
-
-    /**
-     * @brief _initCANBuffers
-     * @note Fungsi ini digunakan untuk menginisialisasi buffer CAN pada MCP2515.
-     */
-    void _initCANBuffers(void)
-    {
-        byte i, a1, a2, a3;
-
-        byte std = 0;
-        byte ext = 1;
-        uint32_t ulMask = 0x00;
-        uint32_t ulFilt = 0x00;
-
-        // MASK
-        // RXM0SIDH (0x20)	MASK untuk Filter 0 dan Filter 1
-        // RXM1SIDH (0x24)	MASK untuk Filter 2 sampai Filter 5
+        /* Kedua mask = 0, lalu CNF3, CNF2, CNF1, CANINTE */
+        _encodeID(blkC, 1, 0);
+        _encodeID(blkC + 4, 1, 0);
+        blkC[8] = timing.cnf3 | (_wakeFilter ? CNF3_WAKFIL : 0);
+        blkC[9] = timing.cnf2;
+        blkC[10] = timing.cnf1;
+        blkC[11] = INTF_RX0IF | INTF_RX1IF;
 
-        // 0x20 00100000 Set both masks to 0
-        _writeMasknFilter(CTR_RXM0SIDH, ext, ulMask);
-        // 0x24 00100100 Mask register ignores ext bit
-        _writeMasknFilter(CTR_RXM1SIDH, ext, ulMask);
-
-        /* Set all filters to 0         */
-        _writeMasknFilter(CTR_RXF0SIDH, ext, ulFilt); /* RXB0: extended               */
-        _writeMasknFilter(CTR_RXF1SIDH, std, ulFilt); /* RXB1: standard               */
-        _writeMasknFilter(CTR_RXF2SIDH, ext, ulFilt); /* RXB2: extended               */
-        _writeMasknFilter(CTR_RXF3SIDH, std, ulFilt); /* RXB3: standard               */
-        _writeMasknFilter(CTR_RXF4SIDH, ext, ulFilt);
-        _writeMasknFilter(CTR_RXF5SIDH, std, ulFilt);
+        __writeRegisters(CTR_RXF0SIDH, blkA, 14);
+        __writeRegisters(CTR_RXF3SIDH, blkB, 12);
+        __writeRegisters(CTR_RXM0SIDH, blkC, 12);
 
         /* Clear, deactivate the three  */
         /* transmit buffers             */
         /* TXBnCTRL -> TXBnD7           */
-        a1 = CTR_TXB0CTRL;
-        a2 = CTR_TXB1CTRL;
-        a3 = CTR_TXB2CTRL;
-        for (i = 0; i < 14; i++)
-        { /* in-buffer loop               */
-            __writeRegister(a1, 0);
-            __writeRegister(a2, 0);
-            __writeRegister(a3, 0);
-            a1++;
-            a2++;
-            a3++;
+        for (i = 0; i < 3; i++)
+        {
+            const byte cmd[2] = {CMD_WRITE, (byte)(CTR_TXB0CTRL + (i << 4))};
+            _bus.transfer(cmd, 2, 0, 0, 14); // data NULL = 0x00
         }
-        __writeRegister(CTR_RXB0CTRL, 0); // RXB0CTRL    0x60
-        __writeRegister(CTR_RXB1CTRL, 0); // RXB1CTRL    0x70
-    }
-
-    /**
-     * @brief _readReceivMsg
-     * @param buffer_sidh_addr Alamat buffer yang akan dibaca
-     * @return void
-     * @note Fungsi ini digunakan untuk membaca pesan yang diterima dari MCP2515.
-     */
-    void _readReceivMsg(const byte buffer_sidh_addr)
-    {
-        byte mcp_addr, ctrl;
-
-        mcp_addr = buffer_sidh_addr;
-
-        _readIDs(mcp_addr, &m_nExtFlg, &m_nID);
-
-        ctrl = __readRegister(mcp_addr - 1);
-        m_nDlc = __readRegister(mcp_addr + 4);
-
-        if (m_nDlc > 8)
-            m_nDlc = 8;
+        _rtrStaged = 0xFF; // TXB2 kosong, jawaban remote frame dimuat ulang saat diminta
+        _rtrDirty = false;
+        if (_txReserved & 0x04)
+            __bitModify(CTR_TXB2CTRL, TXB_TXP_M, TXB_TXP_M); // TXB2 tetap untuk jawaban remote frame
 
-        if (ctrl & 0x08)
-            m_nRtr = 1;
+        if (imod == IMOD_ANY)
+        {
+            rxb0 = RXB_RX_ANY | (1 << 2);
+            rxb1 = RXB_RX_ANY;
+        }
+        else if (imod == IMOD_STD || imod == IMOD_EXT || imod == IMOD_ALL)
+        {
+            rxb0 = RXB_RX_STDEXT | (1 << 2);
+            rxb1 = RXB_RX_STDEXT;
+        }
         else
-            m_nRtr = 0;
-
-        m_nDlc &= DLC_MASK;
-        __readRegisters(mcp_addr + 5, &(m_nDta[0]), m_nDlc);
+            rxb0 = rxb1 = 0;
+        __writeRegister(CTR_RXB0CTRL, rxb0); // RXB0CTRL    0x60
+        __writeRegister(CTR_RXB1CTRL, rxb1); // RXB1CTRL    0x70
     }
 
     /**
@@ -496,27 +558,22 @@ private:
      */
     byte _readStatus(void)
     {
+        const byte cmd[1] = {CMD_READ_STATUS};
         byte i;
-        _spi->beginTransaction(_spiSettings);
-        __spi_select();
-        __spi_readWrite(CMD_READ_STATUS);
-        i = __spi_read();
-        __spi_unSelect();
-        _spi->endTransaction();
+        _bus.transfer(cmd, 1, 0, &i, 1);
         return i;
     }
 
     /**
-     * @brief _writeIDs
-     * @param mcp_addr Alamat MCP2515
+     * @brief _encodeID
+     * @param tbufdata Array 4 byte untuk menyimpan hasil (SIDH, SIDL, EID8, EID0)
      * @param ext Flag ekstensi untuk ID
-     * @param id ID yang akan ditulis
-     * @note Fungsi ini digunakan untuk menulis ID pada MCP2515.
+     * @param id ID yang akan dikodekan
+     * @note Fungsi ini digunakan untuk mengubah ID menjadi format register SIDH..EID0.
      */
-    void _writeIDs(const byte mcp_addr, const byte ext, const uint32_t id)
+    static void _encodeID(byte tbufdata[4], const byte ext, const uint32_t id)
     {
         uint16_t canid;
-        byte tbufdata[4];
         canid = (uint16_t)(id & 0x0FFFF);
         if (ext == 1)
         {
@@ -535,23 +592,32 @@ private:
             tbufdata[3] = 0;
             tbufdata[2] = 0;
         }
-
-        __writeRegisters(mcp_addr, tbufdata, 4);
     }
 
     /**
-     * @brief _readIDs
+     * @brief _writeIDs
      * @param mcp_addr Alamat MCP2515
      * @param ext Flag ekstensi untuk ID
-     * @param id Pointer ke variabel untuk menyimpan ID
-     * @note Fungsi ini digunakan untuk membaca ID dari MCP2515.
+     * @param id ID yang akan ditulis
+     * @note Fungsi ini digunakan untuk menulis ID pada MCP2515.
      */
-    void _readIDs(const byte mcp_addr, byte *ext, uint32_t *id)
+    void _writeIDs(const byte mcp_addr, const byte ext, const uint32_t id)
     {
         byte tbufdata[4];
+        _encodeID(tbufdata, ext, id);
+        __writeRegisters(mcp_addr, tbufdata, 4);
+    }
+
+    /**
+     * @brief _decodeID
+     * @param tbufdata Array 4 byte register SIDH..EID0
+     * @param ext Pointer untuk menyimpan flag ekstensi
+     * @param id Pointer ke variabel untuk menyimpan ID
+     * @note Fungsi ini kebalikan dari _encodeID.
+     */
+    static void _decodeID(const byte tbufdata[4], byte *ext, uint32_t *id)
+    {
         *ext = 0;
-        *id = 0;
-        __readRegisters(mcp_addr, tbufdata, 4);
         *id = (tbufdata[0] << 3) + (tbufdata[1] >> 5);
         if ((tbufdata[1] & MCP_TXB_EXIDE_M) == MCP_TXB_EXIDE_M)
         {
@@ -564,156 +630,685 @@ private:
     }
 
     /**
-     * @brief _setStdFilt
-     * @param filterNumber Nomor filter (0-5)
-     * @param id Nilai ID yang akan diatur
-     * @note Fungsi ini digunakan untuk mengatur nilai filter pada MCP2515.
+     * @brief _readRxBuffer
+     * @param n Nomor RX buffer (0 atau 1)
+     * @param frame Frame untuk menyimpan hasil
+     * @note Seluruh isi buffer (SIDH..D7) dibaca dengan satu instruksi READ RX BUFFER.
+     * Chip membersihkan RXnIF sendiri saat CS dilepas, jadi tidak perlu BIT MODIFY tambahan.
      */
-    void _setStdFilt(uint8_t filterNumber, uint16_t id)
+    void _readRxBuffer(const byte n, MCP2515Frame &frame)
     {
-        uint8_t sidh = (id >> 3) & 0xFF;
-        uint8_t sidl = (id & 0x07) << 5;
-
-        uint8_t baseAddr;
+        const byte cmd[1] = {(byte)(CMD_READ_RX_BUF | (n << 2))};
+        byte rxb[13], ext;
+
+        _bus.transfer(cmd, 1, 0, rxb, 13);
+        frame.timestamp = _bus.micros();
+
+        _decodeID(rxb, &ext, &frame.id);
+        frame.len = rxb[4] & DLC_MASK;
+        if (frame.len > 8)
+            frame.len = 8;
+        if (ext)
+            frame.id |= 0x80000000;
+        if (ext ? (rxb[4] & RTR_MASK) : (rxb[1] & MCP_RXB_SRR_M))
+            frame.id |= 0x40000000;
+        memcpy(frame.data, &rxb[5], 8);
+    }
 
-        switch (filterNumber)
-        {
-        case 0:
-            baseAddr = 0x00;
-            break; // RXF0SIDH
-        case 1:
-            baseAddr = 0x04;
-            break; // RXF1SIDH
-        case 2:
-            baseAddr = 0x08;
-            break;
-        case 3:
-            baseAddr = 0x10;
-            break;
-        case 4:
-            baseAddr = 0x14;
-            break;
-        case 5:
-            baseAddr = 0x18;
-            break;
-        default:
-            return;
-        }
+    /**
+     * @brief _expired
+     * @param deadline Batas waktu (micros) yang akan diperiksa
+     * @return true jika batas waktu sudah lewat
+     * @note Perbandingan memakai selisih bertanda agar tetap benar saat micros() overflow.
+     */
+    inline bool _expired(const uint32_t deadline) { return (int32_t)(_bus.micros() - deadline) >= 0; }
 
-        __writeRegister(baseAddr, sidh);
-        __writeRegister(baseAddr + 1, sidl);
+    /**
+     * @brief _setMsg
+     * @param id ID dari pesan
+     * @param rtr Flag remote request
+     * @param ext Flag ekstensi untuk ID
+     * @param len Panjang data
+     * @param buf Pointer ke buffer data
+     * @note Fungsi ini digunakan untuk menyalin pesan ke variabel m_n* sebelum dikirim.
+     */
+    void _setMsg(const uint32_t id, const byte rtr, const byte ext, const byte len, const byte *buf)
+    {
+        m_nID = id;
+        m_nRtr = rtr;
+        m_nExtFlg = ext;
+        m_nDlc = len;
+        if (m_nDlc > 8)
+            m_nDlc = 8;
+        for (byte i = 0; i < m_nDlc; i++)
+            m_nDta[i] = buf[i];
     }
 
     /**
-     * @brief _setStdMaskFilt
-     * @param maskNumber Nomor mask (0 atau 1)
-     * @param mask Nilai mask yang akan diatur
-     * @note Fungsi ini digunakan untuk mengatur nilai mask pada kedua filter RXF0 dan RXF1.
+     * @brief _getNextFreeTXBuf
+     * @param txbuf_n Pointer untuk menyimpan alamat SIDH dari TX buffer yang kosong
+     * @return RSPN_OK jika ada buffer kosong, RSPN_ALLTXBUSSY jika semua terpakai
+     * @note Status TXREQ ketiga buffer dibaca sekaligus lewat READ STATUS (satu transaksi SPI).
      */
-    void _setStdMaskFilt(uint8_t maskNumber, uint16_t mask)
+    byte _getNextFreeTXBuf(byte *txbuf_n)
     {
-        uint8_t sidh = (mask >> 3) & 0xFF;
-        uint8_t sidl = (mask & 0x07) << 5;
+        const byte reqbits[3] = {STAT_TX0REQ, STAT_TX1REQ, STAT_TX2REQ};
+        const byte ctrlregs[3] = {CTR_TXB0CTRL, CTR_TXB1CTRL, CTR_TXB2CTRL};
+        byte stat = _readStatus();
+        byte res = RSPN_ALLTXBUSSY;
 
-        uint8_t baseAddr = (maskNumber == 0) ? 0x20 : 0x24; // RXM0SIDH / RXM1SIDH
-
-        __writeRegister(baseAddr, sidh);
-        __writeRegister(baseAddr + 1, sidl);
+        *txbuf_n = 0x00;
+        for (byte i = 0; i < 3; i++)
+        {
+            if ((stat & reqbits[i]) == 0 && !(_txReserved & (1 << i)))
+            {
+                *txbuf_n = ctrlregs[i] + 1; /* return SIDH-address of Buffer*/
+                res = RSPN_OK;
+            }
+        }
+        return res;
     }
 
-    template <int Step>
+    /**
+     * @brief _writeCanMsg
+     * @param mcp_addr Alamat SIDH dari TX buffer
+     * @note Fungsi ini digunakan untuk memuat pesan m_n* ke TX buffer (tanpa mengirim).
+     */
+    void _writeCanMsg(const byte mcp_addr)
+    {
+        const byte n = (mcp_addr - CTR_TXB0CTRL) >> 4;
+        const byte cmd[1] = {(byte)(CMD_LOAD_TX_BUF | (n << 1))};
+        byte txb[13];
+
+        // buffer ini diisi pesan baru, deadline lama tidak berlaku lagi
+        _txArmed &= ~(1 << n);
+        // TXnIF hanya diset chip jika pesan benar-benar terkirim, jadi dibersihkan sebelum dimuat
+        __bitModify(CTR_CANINTF, INTF_TX0IF << n, 0);
+
+        // SIDH, SIDL, EID8, EID0, DLC, D0..D7 dalam satu instruksi LOAD TX BUFFER
+        _encodeID(txb, m_nExtFlg, m_nID);
+        txb[4] = m_nDlc | ((m_nRtr == 1) ? RTR_MASK : 0);
+        memcpy(&txb[5], m_nDta, m_nDlc);
+        _bus.transfer(cmd, 1, txb, 0, 5 + m_nDlc);
+    }
 
-    class Filter
+    /**
+     * @brief _queueMsg
+     * @param txp Prioritas TX buffer (0..3)
+     * @param arm true untuk memasang deadline
+     * @param deadline Batas waktu absolut dalam micros()
+     * @param txbuf Pointer untuk menyimpan nomor TX buffer (opsional)
+     * @return RSPN_OK atau RSPN_ALLTXBUSSY
+     * @note Fungsi ini memuat pesan m_n* ke TX buffer kosong lalu mengatur TXREQ dan TXP
+     * dengan satu BIT MODIFY, tanpa menunggu pesan terkirim.
+     */
+    byte _queueMsg(const byte txp, const bool arm, const uint32_t deadline, byte *txbuf)
     {
-    private:
-        MCP2515 &parent;
+        byte txbuf_n, n;
 
-    public:
-        Filter(MCP2515 &par) : parent(par) {}
+        if (_getNextFreeTXBuf(&txbuf_n) != RSPN_OK)
+            return RSPN_ALLTXBUSSY;
+        _writeCanMsg(txbuf_n);
 
-        // Filter-0 => RXF0 (Register 0b00000000 – RXF0SIDH)
-        template <int S = Step, typename std::enable_if<S == 0, int>::type = 0>
-        Filter<1> filter0(uint16_t id)
+        n = (txbuf_n - CTR_TXB0CTRL) >> 4;
+        if (arm)
         {
-            parent._setStdFilt(0, id);
-            return Filter<1>(parent);
+            _txDeadline[n] = deadline;
+            _txArmed |= (1 << n);
         }
+        if (txbuf)
+            *txbuf = n;
+        __bitModify(txbuf_n - 1, TXB_TXREQ_M | TXB_TXP_M, TXB_TXREQ_M | (txp & TXB_TXP_M));
+        return RSPN_OK;
+    }
 
-        // Filter-1 => RXF1 (Register 0b00000100 – RXF1SIDH)
-        template <int S = Step, typename std::enable_if<S == 1, int>::type = 0>
-        Filter<2> filter1(uint16_t id)
-        {
-            parent._setStdFilt(1, id);
-            return Filter<2>(parent);
-        }
-        // Filter-2 => RXF2 (Register 0b00001000 – RXF2SIDH)
-        template <int S = Step, typename std::enable_if<S == 2, int>::type = 0>
-        Filter<3> filter2(uint16_t id)
-        {
-            parent._setStdFilt(2, id);
-            return Filter<3>(parent);
-        }
-        // Filter-3 => RXF3 (Register 0b00010000 – RXF3SIDH)
-        template <int S = Step, typename std::enable_if<S == 3, int>::type = 0>
-        Filter<4> filter3(uint16_t id)
-        {
-            parent._setStdFilt(3, id);
-            return Filter<4>(parent);
-        }
-        // Filter-4 => RXF4 (Register 0b00011000 – RXF4SIDH)
-        template <int S = Step, typename std::enable_if<S == 4, int>::type = 0>
-        Filter<5> filter4(uint16_t id)
-        {
-            parent._setStdFilt(4, id);
-            return Filter<5>(parent);
-        }
+    /**
+     * @brief _rtrFind
+     * @param key ID + flag extended (tanpa flag remote)
+     * @return Indeks slot atau 0xFF jika tidak ada
+     */
+    byte _rtrFind(const uint32_t key)
+    {
+        for (byte i = 0; i < MCP2515_RTR_SLOTS; i++)
+            if (_rtr[i].len != 0xFF && _rtr[i].id == key)
+                return i;
+        return 0xFF;
+    }
 
-        // Filter-5 => RXF5 (Register 0b00100000 – RXF5SIDH)
-        template <int S = Step, typename std::enable_if<S == 5, int>::type = 0>
-        void filter5(uint16_t id)
-        {
-            parent._setStdFilt(5, id);
-        }
-    };
+    /**
+     * @brief _rtrLoad
+     * @param i Indeks slot
+     * @return true jika slot tersalin utuh ke m_n*
+     * @note Pembaca seqlock tanpa menunggu: jika setRemoteResponse() sedang mengubah slot
+     * (dari ISR yang menyela penulis, atau dari core lain), salinan ditolak dan m_n* tidak
+     * diubah. Pemanggil lalu memakai jawaban sebelumnya yang masih ada di TXB2.
+     */
+    bool _rtrLoad(const byte i)
+    {
+        byte seq, len, data[8];
+        seq = __atomic_load_n(&_rtr[i].seq, __ATOMIC_ACQUIRE);
+        if (seq & 1)
+            return false;
+        len = _rtr[i].len;
+        if (len > 8)
+            return false;
+        memcpy(data, _rtr[i].data, len);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&_rtr[i].seq, __ATOMIC_RELAXED) != seq)
+            return false;
+        _setMsg(_rtr[i].id & 0x1FFFFFFF, 0, (_rtr[i].id & 0x80000000) ? 1 : 0, len, data);
+        return true;
+    }
 
-public:
     /**
-     * @brief Set Mask Filter
-     * @param mask0 Mask 0 (RXM0SIDH)
-     * @param mask1 Mask 1 (RXM1SIDH)
-     * @return Gunakan Filter<0> untuk melanjutkan konfigurasi filter.
-     * @note Fungsi ini digunakan untuk mengatur nilai mask pada kedua filter RXF0 dan RXF1.
+     * @brief _rtrRespond
+     * @param frame Remote frame yang baru dibaca
+     * @note Jika jawaban sudah ada di TXB2, cukup satu RTS (atau pulsa pin TX2RTS).
      */
-    Filter<0> setMaskFilt(uint16_t mask0, uint16_t mask1 = 0x0000)
+    void _rtrRespond(const MCP2515Frame &frame)
     {
-        uint8_t result = _setCANCTRL(REQ_CONFIG);
-        if (result != RSPN_OK)
-        {
-            Serial.println("Mode Konfigurasi Gagal dimuat!");
-        }
+        byte i = _rtrFind(frame.id & 0x9FFFFFFF);
+        if (i == 0xFF)
+            return;
 
-        _setStdMaskFilt(0, mask0);
-        if (mask1 == 0x0000)
+        if (_readStatus() & STAT_TX2REQ)
         {
-            _setStdMaskFilt(1, mask0);
+            // TXB2 masih mengirim jawaban sebelumnya
+            if (!_rtrLoad(i) || _queueMsg(3, false, 0, 0) != RSPN_OK)
+            {
+                _rtrStats.dropped++;
+                return;
+            }
+            _rtrStats.fallback++;
         }
         else
         {
-            _setStdMaskFilt(1, mask1);
-        }
-        result = _setCANCTRL(_opsModeUse);
-        return Filter<0>(*this);
-    }
-
-public:
-    MCP2515(uint8_t CS_PIN) : _cs(CS_PIN),
-                              _spi(&SPI),
-                              _spiSettings(SPISettings(10000000, MSBFIRST, SPI_MODE0)) {}
-
-    /**
-     * @brief initialize
-     * @param opsMod Mode operasi yang diinginkan (normal, sleep, loopback, listen-only, atau konfigurasi).
-     * @param imod Mode ID (standar, extended, atau semua).
+            if (_rtrStaged != i || _rtrDirty)
+            {
+                if (_rtrLoad(i))
+                {
+                    _writeCanMsg(CTR_TXB2CTRL + 1);
+                    _rtrStaged = i;
+                    _rtrDirty = false;
+                    _rtrStats.restaged++;
+                }
+                else if (_rtrStaged != i)
+                {
+                    _rtrStats.dropped++;
+                    return;
+                }
+                // Slot sedang diubah: kirim jawaban sebelumnya yang masih ada di TXB2
+            }
+#if defined(ARDUINO)
+            if (_rtrPin >= 0)
+            {
+                digitalWrite(_rtrPin, LOW);
+                digitalWrite(_rtrPin, HIGH);
+            }
+            else
+#endif
+            {
+                const byte cmd[1] = {CMD_RTS | 0x04};
+                _bus.transfer(cmd, 1, 0, 0, 0);
+            }
+        }
+
+        uint32_t lat = _bus.micros() - frame.timestamp;
+        if (_rtrStats.responses == 0 || lat < _rtrStats.latMinUs)
+            _rtrStats.latMinUs = lat;
+        if (lat > _rtrStats.latMaxUs)
+            _rtrStats.latMaxUs = lat;
+        _rtrStats.latLastUs = lat;
+        _rtrStats.responses++;
+    }
+
+    /**
+     * @brief _baudCandidate
+     * @param mhz Frekuensi kristal dalam MHz (8, 16, atau 20)
+     * @param i Urutan kandidat
+     * @return Nilai SPEED, atau 0 jika kandidat habis
+     * @note Urutan dari bitrate yang paling umum: 500K, 250K, 125K, 1000K, 100K, 50K, 83K3, 33K3,
+     * 20K, 200K, 80K, 40K, 95K, 31K25, 10K, 5K (hanya yang ada di tabel SPEED untuk kristal ini).
+     */
+    static uint32_t _baudCandidate(const byte mhz, const byte i)
+    {
+        switch (mhz)
+        {
+        case 8:
+            switch (i)
+            {
+            case 0: return SPD_8MHz_500K;
+            case 1: return SPD_8MHz_250K;
+            case 2: return SPD_8MHz_125K;
+            case 3: return SPD_8MHz_1000K;
+            case 4: return SPD_8MHz_100K;
+            case 5: return SPD_8MHz_50K;
+            case 6: return SPD_8MHz_33K3;
+            case 7: return SPD_8MHz_20K;
+            case 8: return SPD_8MHz_200K;
+            case 9: return SPD_8MHz_80K;
+            case 10: return SPD_8MHz_40K;
+            case 11: return SPD_8MHz_31K25;
+            case 12: return SPD_8MHz_10K;
+            case 13: return SPD_8MHz_5K;
+            }
+            break;
+        case 16:
+            switch (i)
+            {
+            case 0: return SPD_16MHz_500K;
+            case 1: return SPD_16MHz_250K;
+            case 2: return SPD_16MHz_125K;
+            case 3: return SPD_16MHz_1000K;
+            case 4: return SPD_16MHz_100K;
+            case 5: return SPD_16MHz_50K;
+            case 6: return SPD_16MHz_83K3;
+            case 7: return SPD_16MHz_33K3;
+            case 8: return SPD_16MHz_20K;
+            case 9: return SPD_16MHz_200K;
+            case 10: return SPD_16MHz_80K;
+            case 11: return SPD_16MHz_40K;
+            case 12: return SPD_16MHz_95K;
+            case 13: return SPD_16MHz_10K;
+            case 14: return SPD_16MHz_5K;
+            }
+            break;
+        case 20:
+            switch (i)
+            {
+            case 0: return SPD_20MHz_500K;
+            case 1: return SPD_20MHz_250K;
+            case 2: return SPD_20MHz_125K;
+            case 3: return SPD_20MHz_1000K;
+            case 4: return SPD_20MHz_100K;
+            case 5: return SPD_20MHz_50K;
+            case 6: return SPD_20MHz_83K3;
+            case 7: return SPD_20MHz_33K3;
+            case 8: return SPD_20MHz_200K;
+            case 9: return SPD_20MHz_80K;
+            case 10: return SPD_20MHz_40K;
+            }
+            break;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief _autoBaudTry
+     * @param canSpeed Kandidat CNF1/CNF2/CNF3
+     * @param dwellUs Lama mendengarkan maksimum
+     * @param confirm Jumlah frame valid untuk langsung menerima kandidat
+     * @return RSPN_OK (frame valid tanpa error), RSPN_FAILTX (error frame, MERRF), RSPN_NOMSG (bus diam),
+     * atau RSPN_FAIL (mode tidak bisa diubah)
+     * @note Hanya CNF1..CNF3 yang ditulis (satu burst). Listen-Only Mode tidak pernah mengirim
+     * (termasuk ACK dan error frame), jadi node tidak mengganggu bus selama pencarian.
+     */
+    byte _autoBaudTry(const uint32_t canSpeed, const uint32_t dwellUs, const byte confirm)
+    {
+        byte cnf[3];
+        cnf[0] = (canSpeed & 0xFF) | (_wakeFilter ? CNF3_WAKFIL : 0); // CNF3
+        cnf[1] = (canSpeed >> 8) & 0xFF;                              // CNF2
+        cnf[2] = (canSpeed >> 16) & 0xFF;                             // CNF1
+
+        if (_toRequestMode(REQ_CONFIG) != RSPN_OK)
+            return RSPN_FAIL;
+        __writeRegisters(CTR_CNF3, cnf, 3);
+        __bitModify(CTR_CANINTF, INTF_MERRF | INTF_RX0IF | INTF_RX1IF, 0);
+        if (_toRequestMode(REQ_LISTENONLY) != RSPN_OK)
+            return RSPN_FAIL;
+
+        uint32_t start = _bus.micros();
+        byte got = 0, flags;
+        do
+        {
+            flags = __readRegister(CTR_CANINTF);
+            if (flags & INTF_MERRF)
+                return RSPN_FAILTX; // bitrate salah: frame di bus terbaca sebagai error
+            if (flags & (INTF_RX0IF | INTF_RX1IF))
+            {
+                got += ((flags & INTF_RX0IF) ? 1 : 0) + ((flags & INTF_RX1IF) ? 1 : 0);
+                if (got >= confirm)
+                    return RSPN_OK;
+                __bitModify(CTR_CANINTF, INTF_RX0IF | INTF_RX1IF, 0);
+            }
+        } while (_bus.micros() - start < dwellUs);
+        return got ? RSPN_OK : RSPN_NOMSG;
+    }
+
+    /**
+     * @brief _autoBaud
+     * @note Inti autoBaud(): kandidat dari list, atau dari _baudCandidate() jika list NULL.
+     */
+    byte _autoBaud(const byte mhz, const SPEED *list, const byte n, SPEED *found, uint32_t *elapsedUs,
+                   const uint32_t dwellMs, const byte confirm)
+    {
+        uint32_t start = _bus.micros();
+        byte saved[3], rxb0, rxb1, i, res, errors = 0;
+        bool ok = false;
+
+        // Simpan bit timing dan mode RX lama selagi masih on-bus
+        __readRegisters(CTR_CNF3, saved, 3);
+        rxb0 = __readRegister(CTR_RXB0CTRL);
+        rxb1 = __readRegister(CTR_RXB1CTRL);
+
+        if (_setCANCTRL(REQ_CONFIG) != RSPN_OK)
+            return RSPN_FAIL;
+        // Terima semua frame valid, tanpa filter
+        __bitModify(CTR_RXB0CTRL, RXB_RX_MASK, RXB_RX_ANY);
+        __bitModify(CTR_RXB1CTRL, RXB_RX_MASK, RXB_RX_ANY);
+
+        for (i = 0; !list || i < n; i++)
+        {
+            uint32_t cand = list ? (uint32_t)list[i] : _baudCandidate(mhz, i);
+            if (!cand)
+                break;
+            res = _autoBaudTry(cand, dwellMs * 1000UL, confirm);
+            if (res == RSPN_OK)
+            {
+                if (found)
+                    *found = (SPEED)cand;
+                ok = true;
+                break;
+            }
+            if (res == RSPN_FAIL)
+                break;
+            if (res == RSPN_FAILTX)
+                errors++;
+        }
+
+        if (_toRequestMode(REQ_CONFIG) == RSPN_OK)
+        {
+            if (!ok)
+                __writeRegisters(CTR_CNF3, saved, 3);
+            __bitModify(CTR_CANINTF, INTF_MERRF | INTF_RX0IF | INTF_RX1IF, 0);
+        }
+        __writeRegister(CTR_RXB0CTRL, rxb0);
+        __writeRegister(CTR_RXB1CTRL, rxb1);
+        res = _toRequestMode(_opsModeUse);
+
+        if (elapsedUs)
+            *elapsedUs = _bus.micros() - start;
+        if (res != RSPN_OK)
+            return RSPN_FAIL;
+        if (ok)
+            return RSPN_OK;
+        return errors ? RSPN_FAIL : RSPN_NOMSG;
+    }
+
+    /**
+     * @brief _txSent
+     * @param n Nomor TX buffer (0..2)
+     * @return RSPN_OK jika TXnIF aktif (pesan terkirim), RSPN_FAILTX jika tidak
+     * @note Panggil setelah TXREQ bernilai 0. Membersihkan TXREQ satu buffer tidak menyetel ABTF
+     * (hanya ABAT yang menyetelnya), jadi hasil pengiriman dinilai dari TXnIF di CANINTF.
+     */
+    byte _txSent(const byte n)
+    {
+        return (__readRegister(CTR_CANINTF) & (INTF_TX0IF << n)) ? RSPN_OK : RSPN_FAILTX;
+    }
+
+public:
+    /**
+     * @brief Reconfig
+     * @note Kumpulan perubahan konfigurasi (bitrate, mode, mask, filter, interrupt) yang
+     * diterapkan sekaligus oleh apply() dalam satu jendela Configuration Mode.
+     * Register yang tidak ikut berubah dibaca lebih dulu (selagi masih on-bus), lalu setiap
+     * blok register ditulis dengan satu burst write.
+     */
+    class Reconfig
+    {
+    private:
+        enum RCFLAG
+        {
+            RC_SPEED = 0x01,
+            RC_MODE = 0x02,
+            RC_INTE = 0x04,
+        };
+        MCP2515Base &parent;
+        byte _set = 0;     // RC_*
+        byte _maskSet = 0; // bit n = mask n berubah
+        byte _filtSet = 0; // bit n = filter n berubah
+        byte _cnf[3];      // CNF3, CNF2, CNF1 (urutan alamat 0x28..0x2A)
+        byte _inte = 0;
+        OPSMOD _mode = REQ_NORMAL;
+        byte _mask[2][4];
+        byte _filt[6][4];
+
+        // Blok register filter: RXF0..RXF2 di 0x00, RXF3..RXF5 di 0x10
+        static byte _filtOffset(const byte n) { return (n < 3) ? n * 4 : (n - 3) * 4; }
+
+    public:
+        Reconfig(MCP2515Base &par) : parent(par) {}
+
+        Reconfig &bitrate(SPEED canSpeed)
+        {
+            _cnf[2] = (canSpeed >> 16) & 0xFF; // CNF1
+            _cnf[1] = (canSpeed >> 8) & 0xFF;  // CNF2
+            _cnf[0] = canSpeed & 0xFF;         // CNF3
+            _set |= RC_SPEED;
+            return *this;
+        }
+        Reconfig &bitrate(const MCP2515BitTiming &timing)
+        {
+            _cnf[2] = timing.cnf1;
+            _cnf[1] = timing.cnf2;
+            _cnf[0] = timing.cnf3;
+            _set |= RC_SPEED;
+            return *this;
+        }
+        Reconfig &mode(OPSMOD opsMod)
+        {
+            _mode = opsMod;
+            _set |= RC_MODE;
+            return *this;
+        }
+        Reconfig &mask(byte n, uint32_t id, byte ext = 0)
+        {
+            if (n > 1)
+                return *this;
+            _encodeID(_mask[n], ext, id);
+            _maskSet |= (1 << n);
+            return *this;
+        }
+        Reconfig &filter(byte n, uint32_t id, byte ext = 0)
+        {
+            if (n > 5)
+                return *this;
+            _encodeID(_filt[n], ext, id);
+            _filtSet |= (1 << n);
+            return *this;
+        }
+        Reconfig &interrupts(byte inte)
+        {
+            _inte = inte;
+            _set |= RC_INTE;
+            return *this;
+        }
+        bool empty(void) const { return !_set && !_maskSet && !_filtSet; }
+
+        /**
+         * @brief apply
+         * @param offBusUs Pointer untuk menyimpan lama waktu off-bus dalam mikrodetik (opsional)
+         * @return Kode status
+         * @note Fungsi ini menerapkan semua perubahan dalam satu kali masuk Configuration Mode.
+         */
+        byte apply(uint32_t *offBusUs = 0)
+        {
+            byte blkA[12], blkB[12], blkC[12]; // 0x00..0x0B, 0x10..0x1B, 0x20..0x2B
+            bool touchA = (_filtSet & 0x07) != 0;
+            bool touchB = (_filtSet & 0x38) != 0;
+            bool touchC = _maskSet || (_set & RC_SPEED);
+            bool needConfig = touchA || touchB || touchC;
+            byte i, res = RSPN_OK;
+            OPSMOD target = (_set & RC_MODE) ? _mode : parent._opsModeUse;
+
+            // Baca register yang tidak ikut berubah selagi node masih on-bus
+            if (touchA && (_filtSet & 0x07) != 0x07)
+                parent.__readRegisters(CTR_RXF0SIDH, blkA, 12);
+            if (touchB && (_filtSet & 0x38) != 0x38)
+                parent.__readRegisters(CTR_RXF3SIDH, blkB, 12);
+            if (touchC && !(_maskSet == 0x03 && (_set & RC_SPEED) && (_set & RC_INTE)))
+                parent.__readRegisters(CTR_RXM0SIDH, blkC, 12);
+
+            for (i = 0; i < 6; i++)
+                if (_filtSet & (1 << i))
+                    memcpy(((i < 3) ? blkA : blkB) + _filtOffset(i), _filt[i], 4);
+            for (i = 0; i < 2; i++)
+                if (_maskSet & (1 << i))
+                    memcpy(blkC + i * 4, _mask[i], 4);
+            if (_set & RC_SPEED)
+            {
+                memcpy(blkC + 8, _cnf, 3);
+                if (parent._wakeFilter)
+                    blkC[8] |= CNF3_WAKFIL;
+                parent._wakeFilterReg = parent._wakeFilter;
+            }
+            if (_set & RC_INTE)
+                blkC[11] = _inte;
+
+            uint32_t temp = parent._bus.micros();
+            if (needConfig)
+            {
+                if (parent._setCANCTRL(REQ_CONFIG) != RSPN_OK)
+                    return RSPN_FAIL;
+                if (touchA)
+                    parent.__writeRegisters(CTR_RXF0SIDH, blkA, 12);
+                if (touchB)
+                    parent.__writeRegisters(CTR_RXF3SIDH, blkB, 12);
+                if (touchC)
+                    parent.__writeRegisters(CTR_RXM0SIDH, blkC, 12);
+            }
+            if (!touchC && (_set & RC_INTE))
+                parent.__writeRegister(CTR_CANINTE, _inte); // CANINTE bisa ditulis di semua mode
+
+            if (needConfig || (_set & RC_MODE))
+                res = parent._setCANCTRL(target);
+
+            parent._lastOffBusUs = parent._bus.micros() - temp;
+            if (offBusUs)
+                *offBusUs = parent._lastOffBusUs;
+            if (res == RSPN_OK)
+                parent._opsModeUse = target;
+            _set = _maskSet = _filtSet = 0;
+            return res;
+        }
+    };
+
+private:
+    uint32_t _lastOffBusUs = 0;
+
+    template <int Step>
+
+    class Filter
+    {
+    private:
+        mutable Reconfig rc;
+        mutable bool _commit; // hanya objek terakhir dalam rantai yang menerapkan perubahan
+
+    public:
+        Filter(const Reconfig &r) : rc(r), _commit(true) {}
+        Filter(const Filter &o) : rc(o.rc), _commit(o._commit) { o._commit = false; }
+        ~Filter()
+        {
+            if (_commit && rc.apply() != RSPN_OK)
+                MCP2515_LOG("Mode Konfigurasi Gagal dimuat!");
+        }
+
+        // Filter-0 => RXF0 (Register 0b00000000 – RXF0SIDH)
+        template <int S = Step, typename std::enable_if<S == 0, int>::type = 0>
+        Filter<1> filter0(uint16_t id)
+        {
+            _commit = false;
+            return Filter<1>(rc.filter(0, id));
+        }
+
+        // Filter-1 => RXF1 (Register 0b00000100 – RXF1SIDH)
+        template <int S = Step, typename std::enable_if<S == 1, int>::type = 0>
+        Filter<2> filter1(uint16_t id)
+        {
+            _commit = false;
+            return Filter<2>(rc.filter(1, id));
+        }
+        // Filter-2 => RXF2 (Register 0b00001000 – RXF2SIDH)
+        template <int S = Step, typename std::enable_if<S == 2, int>::type = 0>
+        Filter<3> filter2(uint16_t id)
+        {
+            _commit = false;
+            return Filter<3>(rc.filter(2, id));
+        }
+        // Filter-3 => RXF3 (Register 0b00010000 – RXF3SIDH)
+        template <int S = Step, typename std::enable_if<S == 3, int>::type = 0>
+        Filter<4> filter3(uint16_t id)
+        {
+            _commit = false;
+            return Filter<4>(rc.filter(3, id));
+        }
+        // Filter-4 => RXF4 (Register 0b00011000 – RXF4SIDH)
+        template <int S = Step, typename std::enable_if<S == 4, int>::type = 0>
+        Filter<5> filter4(uint16_t id)
+        {
+            _commit = false;
+            return Filter<5>(rc.filter(4, id));
+        }
+
+        // Filter-5 => RXF5 (Register 0b00100000 – RXF5SIDH)
+        template <int S = Step, typename std::enable_if<S == 5, int>::type = 0>
+        void filter5(uint16_t id)
+        {
+            rc.filter(5, id);
+        }
+    };
+
+public:
+    /**
+     * @brief Set Mask Filter
+     * @param mask0 Mask 0 (RXM0SIDH)
+     * @param mask1 Mask 1 (RXM1SIDH)
+     * @return Gunakan Filter<0> untuk melanjutkan konfigurasi filter.
+     * @note Fungsi ini digunakan untuk mengatur nilai mask pada kedua filter RXF0 dan RXF1.
+     * Mask dan filter dalam satu rantai (mis. setMaskFilt(..).filter0(..)) dikumpulkan lalu
+     * diterapkan sekaligus di akhir statement dalam satu jendela Configuration Mode.
+     */
+    Filter<0> setMaskFilt(uint16_t mask0, uint16_t mask1 = 0x0000)
+    {
+        Reconfig rc(*this);
+        rc.mask(0, mask0).mask(1, (mask1 == 0x0000) ? mask0 : mask1);
+        return Filter<0>(rc);
+    }
+
+    /**
+     * @brief reconfigure
+     * @return Objek Reconfig kosong untuk mengumpulkan perubahan konfigurasi
+     * @note Contoh: can.reconfigure().bitrate(SPD_8MHz_250K).mask(0, 0x7F0).filter(0, 0x100).apply(&us);
+     */
+    Reconfig reconfigure(void) { return Reconfig(*this); }
+
+    /**
+     * @brief lastOffBusMicros
+     * @return Lama waktu off-bus (mikrodetik) dari Reconfig::apply() terakhir
+     */
+    uint32_t lastOffBusMicros(void) const { return _lastOffBusUs; }
+
+public:
+    MCP2515Base(const TRANSPORT &bus) : _bus(bus)
+    {
+        for (byte i = 0; i < MCP2515_RTR_SLOTS; i++)
+        {
+            _rtr[i].seq = 0;    // genap = tidak sedang diubah
+            _rtr[i].len = 0xFF; // semua slot jawaban remote frame kosong
+        }
+    }
+
+    /**
+     * @brief transport
+     * @return Referensi ke objek transport SPI yang dipakai driver
+     */
+    TRANSPORT &transport(void) { return _bus; }
+
+    /**
+     * @brief initialize
+     * @param opsMod Mode operasi yang diinginkan (normal, sleep, loopback, listen-only, atau konfigurasi).
+     * @param imod Mode ID (standar, extended, atau semua).
      * @param canSpeed Kecepatan CAN yang diinginkan (1000K, 500K, 250K, dll).
      * @return 1 jika berhasil, 0 jika gagal.
      * @note Fungsi ini digunakan untuk menginisialisasi MCP2515 dengan mode operasi,
@@ -721,53 +1316,51 @@ public:
      */
     byte initialize(OPSMOD opsMod, IDMOD imod, SPEED canSpeed)
     {
-        pinMode(_cs, OUTPUT);
-        __spi_unSelect();
-        _spi->begin();
-        //
-
-        uint8_t result = _setCANCTRL(REQ_CONFIG);
-        if (result != RSPN_OK)
-        {
-            Serial.println("Mode Konfigurasi Gagal dimuat!");
-        }
-
         /**
          * mengkonfigurasi BitRate
          * mengambil nilai enum dari parameter canSpeed, kemudian
          * memecahnya menjadi 3 byte (bagian)
          */
-        byte cfg1 = (canSpeed >> 16) & 0xFF; // Ambil byte paling atas (cfg1)
-        byte cfg2 = (canSpeed >> 8) & 0xFF;  // Ambil byte tengah (cfg2)
-        byte cfg3 = canSpeed & 0xFF;         // Ambil byte paling bawah (cfg3)
+        MCP2515BitTiming timing;
+        timing.cnf1 = (canSpeed >> 16) & 0xFF; // Ambil byte paling atas (cfg1)
+        timing.cnf2 = (canSpeed >> 8) & 0xFF;  // Ambil byte tengah (cfg2)
+        timing.cnf3 = canSpeed & 0xFF;         // Ambil byte paling bawah (cfg3)
+        timing.valid = true;
+        timing.bitrate = 0;
+        timing.samplePermille = 0;
+        return initialize(opsMod, imod, timing);
+    }
 
-        __writeRegister(0x2A, cfg1); // 00101010 CNF1
-        __writeRegister(0x29, cfg2); // 00101001 CNF2
-        __writeRegister(0x28, cfg3); // 00101000 CNF3
+    /**
+     * @brief initialize
+     * @param opsMod Mode operasi yang akan digunakan
+     * @param imod Mode ID yang akan digunakan
+     * @param timing Nilai CNF1/CNF2/CNF3, mis. MCP2515Timing<16000000, 500000>::get() dari mcp2515-SUN-timing.h
+     * @return 1 jika berhasil, 0 jika gagal (termasuk timing.valid == false).
+     * @note Waktu dari awal inisialisasi sampai chip siap di bus dapat dibaca dengan lastInitMicros().
+     */
+    byte initialize(OPSMOD opsMod, IDMOD imod, const MCP2515BitTiming &timing)
+    {
+        _bus.begin();
+        uint32_t start = _bus.micros();
 
-        if (result == RSPN_OK)
+        uint8_t result = _setCANCTRL(REQ_CONFIG);
+        if (result != RSPN_OK)
         {
-            // initialize Buffers
-            _initCANBuffers();
-            // interrupt Mode
-            __writeRegister(CTR_CANINTE, INTF_RX0IF | INTF_RX1IF);
-            // Sets BF pins as GPO
-            __writeRegister(CTR_BFPCTRL, MASK_BxBFS | MASK_BxBFE);
-            // Sets RTS pins as GPI
-            __writeRegister(CTR_TXRTSCTRL, 0x00);
+            MCP2515_LOG("Mode Konfigurasi Gagal dimuat!");
+        }
+        if (!timing.valid)
+            result = RSPN_FAIL;
 
-            if (imod == IMOD_ANY)
-            {
-                __bitModify(CTR_RXB0CTRL, RXB_RX_MASK | (1 << 2), RXB_RX_ANY | (1 << 2));
-                __bitModify(CTR_RXB1CTRL, RXB_RX_MASK, RXB_RX_ANY);
-            }
-            else if (imod == IMOD_STD || imod == IMOD_EXT || imod == IMOD_ALL)
-            {
-                __bitModify(CTR_RXB0CTRL, RXB_RX_MASK | (1 << 2), RXB_RX_STDEXT | (1 << 2));
-                __bitModify(CTR_RXB1CTRL, RXB_RX_MASK, RXB_RX_STDEXT);
-            }
+        if (result == RSPN_OK)
+        {
+            // Filter, mask, bitrate, interrupt, pin, dan buffer dalam beberapa burst write
+            _writeInitImage(timing, imod);
+            _wakeFilterReg = _wakeFilter;
+            __bitModify(CTR_CANCTRL, CTRL_OSM, _oneShot ? CTRL_OSM : 0);
             result = _setCANCTRL(opsMod);
         }
+        _lastInitUs = _bus.micros() - start;
         if (result == RSPN_OK)
         {
             _opsModeUse = opsMod;
@@ -776,6 +1369,142 @@ public:
         return false;
     }
 
+    /**
+     * @brief lastInitMicros
+     * @return Lama initialize() terakhir (mikrodetik), dari permintaan Configuration Mode sampai mode operasi aktif
+     */
+    uint32_t lastInitMicros(void) const { return _lastInitUs; }
+
+    /**
+     * @brief setWakeFilter
+     * @param enable true untuk mengaktifkan filter low-pass wake-up (WAKFIL, default mati seperti setelah reset)
+     * @note WAKFIL mencegah glitch pendek di bus membangunkan chip. Nilainya ditulis ke CNF3 oleh
+     * initialize()/Reconfig, atau oleh sleep() berikutnya jika berubah setelah inisialisasi.
+     */
+    void setWakeFilter(bool enable) { _wakeFilter = enable; }
+
+    /**
+     * @brief sleep
+     * @return Kode status
+     * @note Masuk Sleep Mode dengan interrupt wake-up (WAKIE) aktif dan WAKIF bersih, sehingga pin INT
+     * aktif saat ada aktivitas bus. Configuration Mode hanya dipakai jika WAKFIL perlu diubah.
+     * Pesan yang sedang dikirim diselesaikan chip lebih dulu.
+     */
+    byte sleep(void)
+    {
+        if (canError)
+            return 100;
+        if (_wakeFilterReg != _wakeFilter)
+        {
+            if (_setCANCTRL(REQ_CONFIG) != RSPN_OK)
+                return RSPN_FAIL;
+            __bitModify(CTR_CNF3, CNF3_WAKFIL, _wakeFilter ? CNF3_WAKFIL : 0);
+            _wakeFilterReg = _wakeFilter;
+        }
+        __bitModify(CTR_CANINTE, INTF_WAKIF, INTF_WAKIF);
+        __bitModify(CTR_CANINTF, INTF_WAKIF, 0);
+        if (_toRequestMode(REQ_SLEEP) != RSPN_OK)
+            return RSPN_FAIL;
+        _sleeping = true;
+        _sleepStats.sleeps++;
+        return RSPN_OK;
+    }
+
+    /**
+     * @brief wake
+     * @param intUs micros() saat pin INT aktif (dicatat di ISR), 0 = mulai dari pemanggilan wake()
+     * @return Kode status
+     * @note Jalur bangun minimal: satu baca CANINTF, permintaan mode operasi, lalu WAKIF dibersihkan
+     * (4 transaksi SPI jika dibangunkan bus). Chip bangun ke Listen-Only Mode dan sudah menerima frame
+     * sejak itu; frame tersebut tetap di RX buffer untuk readFrame(). Frame yang memicu wake-up
+     * sendiri hilang selama osilator chip mulai (sesuai datasheet). Jika WAKIF belum aktif, chip
+     * dibangunkan dari host dengan menyetel WAKIF.
+     */
+    byte wake(uint32_t intUs = 0)
+    {
+        if (canError)
+            return 100;
+        if (!_sleeping)
+            return RSPN_OK;
+        uint32_t start = intUs ? intUs : _bus.micros();
+
+        byte flags = __readRegister(CTR_CANINTF);
+        if (flags & INTF_WAKIF)
+            _sleepStats.busWakes++;
+        else
+        {
+            __bitModify(CTR_CANINTF, INTF_WAKIF, INTF_WAKIF); // WAKIE aktif: chip bangun ke Listen-Only
+            _sleepStats.hostWakes++;
+        }
+        byte res = _toRequestMode(_opsModeUse);
+        __bitModify(CTR_CANINTF, INTF_WAKIF, 0);
+        _sleeping = false;
+
+        _sleepStats.framesAtWake += ((flags & INTF_RX0IF) ? 1 : 0) + ((flags & INTF_RX1IF) ? 1 : 0);
+        _sleepStats.lastWakeUs = _bus.micros() - start;
+        if (_sleepStats.lastWakeUs > _sleepStats.maxWakeUs)
+            _sleepStats.maxWakeUs = _sleepStats.lastWakeUs;
+        return res;
+    }
+
+    /**
+     * @brief sleeping
+     * @return true jika sleep() dipanggil dan wake() belum dipanggil
+     */
+    bool sleeping(void) const { return _sleeping; }
+
+    /**
+     * @brief sleepStats
+     * @return Statistik sleep/wake (jumlah dan latensi wake-to-ready)
+     */
+    const SleepStats &sleepStats(void) const { return _sleepStats; }
+
+    /**
+     * @brief autoBaud
+     * @param oscHz Frekuensi kristal MCP2515 (8, 16, atau 20 MHz; tidak bisa dideteksi lewat SPI)
+     * @param found Pointer untuk menyimpan SPEED yang terdeteksi
+     * @param elapsedUs Pointer untuk menyimpan lama pencarian dalam mikrodetik (opsional)
+     * @param dwellMs Lama maksimum mendengarkan per kandidat
+     * @param confirm Jumlah frame valid untuk langsung menerima kandidat
+     * @return RSPN_OK jika terdeteksi, RSPN_NOMSG jika bus diam, RSPN_FAIL jika tidak ada kandidat yang cocok
+     * @note Kandidat dicoba di Listen-Only Mode (tidak pernah mengirim), urut dari bitrate paling umum.
+     * Kandidat ditolak begitu MERRF muncul, dan diterima begitu ada frame valid. Di antara percobaan
+     * hanya CNF1..CNF3 yang ditulis. Setelah selesai chip kembali ke mode operasi sebelumnya dengan
+     * bitrate yang terdeteksi (atau bitrate lama jika gagal).
+     * @note Lama pencarian ditentukan oleh lama frame di bus, bukan SPI: kandidat salah baru ditolak
+     * saat frame berikutnya selesai, dan kandidat benar butuh `confirm` frame. Frame standar 8 byte
+     * sekitar 111 bit (0.2 ms pada 500K, 22 ms pada 5K), jadi pada 16 MHz bus 5K (kandidat terakhir)
+     * butuh sekitar 0.35 detik. dwellMs harus lebih panjang dari jarak antar frame di bus.
+     * Lihat examples/autobaud_mock.
+     */
+    byte autoBaud(uint32_t oscHz, SPEED *found, uint32_t *elapsedUs = 0, uint32_t dwellMs = 250, byte confirm = 2)
+    {
+        if (canError)
+            return 100;
+        byte mhz = (byte)(oscHz / 1000000UL);
+        if (_baudCandidate(mhz, 0) == 0)
+            return RSPN_FAIL; // tidak ada tabel SPEED untuk kristal ini
+        return _autoBaud(mhz, 0, 0, found, elapsedUs, dwellMs, confirm);
+    }
+
+    /**
+     * @brief autoBaud
+     * @param candidates Daftar SPEED yang dicoba, berurutan
+     * @param n Jumlah kandidat
+     * @param found Pointer untuk menyimpan SPEED yang terdeteksi
+     * @param elapsedUs Pointer untuk menyimpan lama pencarian dalam mikrodetik (opsional)
+     * @param dwellMs Lama maksimum mendengarkan per kandidat
+     * @param confirm Jumlah frame valid untuk langsung menerima kandidat
+     * @return RSPN_OK, RSPN_NOMSG, atau RSPN_FAIL
+     */
+    byte autoBaud(const SPEED *candidates, byte n, SPEED *found, uint32_t *elapsedUs = 0, uint32_t dwellMs = 250,
+                  byte confirm = 2)
+    {
+        if (canError)
+            return 100;
+        return _autoBaud(0, candidates, n, found, elapsedUs, dwellMs, confirm);
+    }
+
     /**
      * @brief writeData
      * @param id ID dari data yang akan dikirimkan
@@ -791,46 +1520,16 @@ public:
             return 100;
         byte res;
 
-        // START fungsi -------- setMsg ------------------
-        // setMsg(id, 0, ext, len, buf);
-        int i = 0;
-        m_nID = id;
-        m_nRtr = 0;
-        m_nExtFlg = ext;
-        m_nDlc = len;
-        if (m_nDlc > 8)
-            m_nDlc = 8;
-        for (i = 0; i < m_nDlc; i++)
-            m_nDta[i] = *(buf + i);
-        // END fungsi ---------- setMsg ------------------
+        _setMsg(id, 0, ext, len, buf);
 
-        // START fungsi ---------- sendMsg ------------------
-        // res = sendMsg();
         byte res1, txbuf_n;
         uint32_t uiTimeOut, temp;
 
-        temp = micros();
-        // 24 * 4 microseconds typical
+        temp = _bus.micros();
         do
         {
-            // START fungsi -------- mcp2515_getNextFreeTXBuf ------------------
-            // res = mcp2515_getNextFreeTXBuf(&txbuf_n); /* info = addr.*/
-            byte i, ctrlval;
-            byte ctrlregs[3] = {CTR_TXB0CTRL, CTR_TXB1CTRL, CTR_TXB2CTRL};
-            res = RSPN_ALLTXBUSSY;
-            txbuf_n = 0x00;
-            for (i = 0; i < 3; i++)
-            {
-                ctrlval = __readRegister(ctrlregs[i]);
-                if ((ctrlval & TXB_TXREQ_M) == 0)
-                {
-                    txbuf_n = ctrlregs[i] + 1; /* return SIDH-address of Buffer*/
-
-                    res = RSPN_OK;
-                }
-            }
-            // END fungsi -------- mcp2515_getNextFreeTXBuf ------------------
-            uiTimeOut = micros() - temp;
+            res = _getNextFreeTXBuf(&txbuf_n); /* info = addr.*/
+            uiTimeOut = _bus.micros() - temp;
         } while (res == RSPN_ALLTXBUSSY && (uiTimeOut < 2500));
 
         if (uiTimeOut >= 2500)
@@ -838,91 +1537,395 @@ public:
             return RSPN_GETTXBFTIMEOUT;
         }
         uiTimeOut = 0;
-        // START fungsi -------- mcp2515_write_canMsg ------------------
-        // mcp2515_write_canMsg(txbuf_n);
-        byte mcp_addr;
-        mcp_addr = txbuf_n;
-        __writeRegisters(mcp_addr + 5, m_nDta, m_nDlc);
-
-        if (m_nRtr == 1)
-            m_nDlc |= RTR_MASK;
-
-        __writeRegister((mcp_addr + 4), m_nDlc);
-        _writeIDs(mcp_addr, m_nExtFlg, m_nID);
-        // END fungsi -------- mcp2515_write_canMsg ------------------
+        _writeCanMsg(txbuf_n);
         __bitModify(txbuf_n - 1, TXB_TXREQ_M, TXB_TXREQ_M);
 
-        temp = micros();
+        temp = _bus.micros();
         do
         {
             res1 = __readRegister(txbuf_n - 1); /* read send buff ctrl reg 	*/
             res1 = res1 & 0x08;
-            uiTimeOut = micros() - temp;
+            uiTimeOut = _bus.micros() - temp;
         } while (res1 && (uiTimeOut < 2500));
 
         if (uiTimeOut >= 2500) /* send msg timeout             */
             return RSPN_SENDMSGTIMEOUT;
 
         return RSPN_OK;
-        // END fungsi ---------- sendMsg ------------------
+    }
 
-        // return res;
+    /**
+     * @brief setOneShot
+     * @param enable true untuk mengaktifkan One-Shot Mode (OSM)
+     * @return Kode status
+     * @note Pada One-Shot Mode setiap pesan hanya dicoba dikirim satu kali. Pesan yang kalah
+     * arbitrasi atau error tidak diulang, sehingga tidak pernah terkirim terlambat.
+     */
+    byte setOneShot(bool enable)
+    {
+        _oneShot = enable;
+        __bitModify(CTR_CANCTRL, CTRL_OSM, enable ? CTRL_OSM : 0);
+        return RSPN_OK;
     }
 
     /**
-     * @brief readData
-     * @param id Pointer ke ID dari data yang diterima
-     * @param len Pointer ke panjang data yang diterima
-     * @param buf Pointer ke buffer untuk menyimpan data yang diterima
-     * @return Kode status dari pembacaan data
-     * @note Fungsi ini digunakan untuk membaca data dari MCP2515.
+     * @brief writeDataUntil
+     * @param id ID dari data yang akan dikirimkan
+     * @param ext Flag ekstensi untuk ID
+     * @param len Panjang data yang akan dikirimkan
+     * @param buf Pointer ke buffer data yang akan dikirimkan
+     * @param deadline Batas waktu absolut dalam micros()
+     * @return RSPN_OK, RSPN_FAILTX, atau RSPN_DEADLINEMISS
+     * @note Fungsi ini seperti writeData, tetapi menunggu paling lama sampai deadline.
+     * Jika deadline lewat, TXREQ dibersihkan sehingga pesan basi tidak tertinggal di TX buffer.
      */
-    byte readData(uint32_t *id, byte *len, byte *buf)
+    byte writeDataUntil(uint32_t id, byte ext, byte len, byte *buf, uint32_t deadline)
     {
         if (canError)
             return 100;
-        // START fungsi -------- readMsg ------------------
-        // if (readMsg() == 4)
-        //     return 4;
-        byte stat, res;
+        byte txbuf_n, n;
 
-        stat = _readStatus();
+        _setMsg(id, 0, ext, len, buf);
+        while (_getNextFreeTXBuf(&txbuf_n) != RSPN_OK)
+        {
+            abortStale();
+            if (_expired(deadline))
+            {
+                _deadlineMisses++;
+                return RSPN_DEADLINEMISS;
+            }
+        }
+        _writeCanMsg(txbuf_n);
+        __bitModify(txbuf_n - 1, TXB_TXREQ_M, TXB_TXREQ_M);
+        n = (txbuf_n - CTR_TXB0CTRL) >> 4;
 
-        if (stat & (1 << 0)) /* Msg in Buffer 0              */
+        do
+        {
+            if ((__readRegister(txbuf_n - 1) & TXB_TXREQ_M) == 0)
+                return _txSent(n);
+        } while (!_expired(deadline));
+
+        // Deadline lewat: batalkan pesan di buffer ini saja. Pesan yang sedang di bus tetap
+        // diselesaikan chip, jadi tunggu TXREQ bernilai 0 sebelum hasilnya dinilai.
+        __bitModify(txbuf_n - 1, TXB_TXREQ_M, 0);
+        uint32_t temp = _bus.micros();
+        while ((__readRegister(txbuf_n - 1) & TXB_TXREQ_M) && (_bus.micros() - temp < 2500))
+            ;
+        if (_txSent(n) == RSPN_OK)
+            return RSPN_OK; // terkirim tepat sebelum dibatalkan
+        _deadlineMisses++;
+        return RSPN_DEADLINEMISS;
+    }
+
+    /**
+     * @brief queueData
+     * @param id ID dari data yang akan dikirimkan
+     * @param ext Flag ekstensi untuk ID
+     * @param len Panjang data yang akan dikirimkan
+     * @param buf Pointer ke buffer data yang akan dikirimkan
+     * @param deadline Batas waktu absolut dalam micros()
+     * @return RSPN_OK, RSPN_ALLTXBUSSY, atau RSPN_DEADLINEMISS
+     * @note Fungsi ini tidak menunggu pesan terkirim. Pesan yang belum terkirim saat deadline
+     * lewat akan dibatalkan oleh abortStale(), yang juga dipanggil di awal fungsi ini.
+     */
+    byte queueData(uint32_t id, byte ext, byte len, byte *buf, uint32_t deadline)
+    {
+        if (canError)
+            return 100;
+
+        abortStale();
+        if (_expired(deadline))
         {
-            _readReceivMsg(CTR_RXB0SIDH);
-            __bitModify(CTR_CANINTF, BIT_RX0IF, 0);
-            res = RSPN_OK;
+            _deadlineMisses++;
+            return RSPN_DEADLINEMISS;
         }
-        else if (stat & (1 << 1)) /* Msg in Buffer 1              */
+        _setMsg(id, 0, ext, len, buf);
+        return _queueMsg(0, true, deadline, 0);
+    }
+
+    /**
+     * @brief queueFrame
+     * @param frame Frame yang akan dikirim (flag extended/remote diambil dari bit 31/30 ID)
+     * @param txp Prioritas TX buffer (0..3). Jika beberapa buffer menunggu, TXP tertinggi dikirim dulu.
+     * @param txbuf Pointer untuk menyimpan nomor TX buffer yang dipakai (opsional)
+     * @return RSPN_OK atau RSPN_ALLTXBUSSY
+     * @note Fungsi ini tidak menunggu dan tidak memasang deadline.
+     */
+    byte queueFrame(const MCP2515Frame &frame, byte txp = 0, byte *txbuf = 0)
+    {
+        if (canError)
+            return 100;
+        _setMsg(frame.id & 0x1FFFFFFF, (frame.id & 0x40000000) ? 1 : 0, (frame.id & 0x80000000) ? 1 : 0,
+                frame.len, frame.data);
+        return _queueMsg(txp, false, 0, txbuf);
+    }
+
+    /**
+     * @brief txPending
+     * @return Bit n = TXBn masih menunggu dikirim (TXREQ)
+     * @note Dibaca dengan satu READ STATUS.
+     */
+    byte txPending(void)
+    {
+        byte stat = _readStatus();
+        return ((stat & STAT_TX0REQ) ? 0x01 : 0) | ((stat & STAT_TX1REQ) ? 0x02 : 0) | ((stat & STAT_TX2REQ) ? 0x04 : 0);
+    }
+
+    /**
+     * @brief txResult
+     * @param txbuf Nomor TX buffer (0..2) dari queueFrame()
+     * @return RSPN_OK jika pesan terkirim, RSPN_FAILTX jika gagal atau dibatalkan
+     * @note Panggil setelah bit buffer ini di txPending() bernilai 0. Hasil dinilai dari TXnIF
+     * (dibersihkan saat buffer dimuat), karena abortTx() tidak menyetel ABTF.
+     */
+    byte txResult(byte txbuf)
+    {
+        return _txSent(txbuf);
+    }
+
+    /**
+     * @brief abortTx
+     * @param txbuf Nomor TX buffer (0..2) dari queueFrame()
+     * @note Pesan yang sedang dikirim tetap diselesaikan chip; hasilnya dibaca dengan txResult().
+     */
+    void abortTx(byte txbuf)
+    {
+        __bitModify(CTR_TXB0CTRL + (txbuf << 4), TXB_TXREQ_M, 0);
+    }
+
+    /**
+     * @brief abortStale
+     * @return Jumlah pesan yang dibatalkan (pesan yang tetap selesai terkirim tidak dihitung)
+     * @note Fungsi ini membatalkan pesan dari queueData() yang deadline-nya sudah lewat.
+     * Jika semua pesan yang menunggu sudah basi, dipakai ABAT (satu perintah untuk semua buffer),
+     * selain itu TXREQ dibersihkan per buffer. Panggil secara berkala dari loop().
+     */
+    byte abortStale(void)
+    {
+        if (!_txArmed)
+            return 0;
+
+        const byte reqbits[3] = {STAT_TX0REQ, STAT_TX1REQ, STAT_TX2REQ};
+        const byte ctrlregs[3] = {CTR_TXB0CTRL, CTR_TXB1CTRL, CTR_TXB2CTRL};
+        byte stat = _readStatus();
+        byte pending = 0, stale = 0, n = 0;
+
+        for (byte i = 0; i < 3; i++)
         {
-            _readReceivMsg(CTR_RXB1SIDH);
-            __bitModify(CTR_CANINTF, BIT_RX1IF, 0);
-            res = RSPN_OK;
+            if (stat & reqbits[i])
+                pending |= (1 << i);
+            if ((_txArmed & (1 << i)) == 0)
+                continue;
+            if ((stat & reqbits[i]) == 0)
+                _txArmed &= ~(1 << i); // sudah terkirim (atau gagal pada One-Shot Mode)
+            else if (_expired(_txDeadline[i]))
+            {
+                stale |= (1 << i);
+                n++;
+            }
         }
+        if (!stale)
+            return 0;
+
+        bool abat = (stale == pending && n > 1);
+        if (abat)
+            __bitModify(CTR_CANCTRL, CTRL_ABAT, CTRL_ABAT);
         else
-            res = RSPN_NOMSG;
+        {
+            for (byte i = 0; i < 3; i++)
+                if (stale & (1 << i))
+                    __bitModify(ctrlregs[i], TXB_TXREQ_M, 0);
+        }
 
-        if (res == RSPN_NOMSG)
+        // Pesan yang sedang di bus tetap diselesaikan chip: tunggu TXREQ bernilai 0, lalu hanya
+        // buffer tanpa TXnIF yang dihitung sebagai pesan basi (sama seperti writeDataUntil()).
+        uint32_t temp = _bus.micros();
+        do
         {
-            return RSPN_NOMSG;
+            stat = _readStatus();
+            pending = 0;
+            for (byte i = 0; i < 3; i++)
+                if (stat & reqbits[i])
+                    pending |= (1 << i);
+        } while ((pending & stale) && (_bus.micros() - temp < 2500));
+        if (abat)
+            __bitModify(CTR_CANCTRL, CTRL_ABAT, 0);
+        stat = __readRegister(CTR_CANINTF);
+        n = 0;
+        for (byte i = 0; i < 3; i++)
+            if ((stale & (1 << i)) && !(stat & (INTF_TX0IF << i)))
+                n++;
+
+        _txArmed &= ~stale;
+        _deadlineMisses += n;
+        return n;
+    }
+
+    /**
+     * @brief deadlineMisses
+     * @return Jumlah pesan yang dibatalkan karena melewati deadline
+     */
+    uint32_t deadlineMisses(void) const { return _deadlineMisses; }
+
+    /**
+     * @brief setRemoteResponse
+     * @param id ID yang dijawab (tanpa flag)
+     * @param ext Flag ekstensi untuk ID
+     * @param len Panjang data jawaban
+     * @param buf Data jawaban
+     * @return RSPN_OK, atau RSPN_FAIL jika semua slot terpakai
+     * @note Saat jawaban pertama didaftarkan, TXB2 dicadangkan untuk jawaban remote frame
+     * (TXP tertinggi) dan tidak dipakai writeData()/queueData(). Jawaban dikirim otomatis oleh
+     * readFrame()/readData() saat remote frame dengan ID ini diterima; frame remote tetap
+     * diteruskan ke aplikasi. Boleh dipanggil kapan saja untuk mengganti data tanpa tearing
+     * (satu penulis): pembaca di ISR atau core lain tidak menunggu, melainkan mengirim jawaban
+     * sebelumnya jika slot sedang diubah.
+     */
+    byte setRemoteResponse(uint32_t id, byte ext, byte len, const byte *buf)
+    {
+        uint32_t key = (id & 0x1FFFFFFF) | (ext ? 0x80000000 : 0);
+        byte i = _rtrFind(key);
+
+        if (i == 0xFF)
+        {
+            for (i = 0; i < MCP2515_RTR_SLOTS; i++)
+                if (_rtr[i].len == 0xFF)
+                    break;
+            if (i == MCP2515_RTR_SLOTS)
+                return RSPN_FAIL;
+            if (_rtrCount == 0)
+            {
+                _txReserved |= 0x04;
+                __bitModify(CTR_TXB2CTRL, TXB_TXP_M, TXB_TXP_M);
+            }
+            _rtr[i].id = key;
+            _rtrCount++;
         }
-        // END fungsi -------- readMsg ------------------
 
-        if (m_nExtFlg)
-            m_nID |= 0x80000000;
+        if (len > 8)
+            len = 8;
+        byte seq = __atomic_load_n(&_rtr[i].seq, __ATOMIC_RELAXED);
+        __atomic_store_n(&_rtr[i].seq, (byte)(seq + 1), __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        memcpy(_rtr[i].data, buf, len);
+        _rtr[i].len = len;
+        __atomic_store_n(&_rtr[i].seq, (byte)(seq + 2), __ATOMIC_RELEASE);
+
+        if (_rtrStaged == i || _rtrStaged == 0xFF)
+        {
+            // Perbarui TXB2 langsung jika tidak sedang mengirim, selain itu muat ulang saat dipicu
+            if ((_readStatus() & STAT_TX2REQ) || !_rtrLoad(i))
+                _rtrDirty = true;
+            else
+            {
+                _writeCanMsg(CTR_TXB2CTRL + 1);
+                _rtrStaged = i;
+                _rtrDirty = false;
+            }
+        }
+        return RSPN_OK;
+    }
 
-        if (m_nRtr)
-            m_nID |= 0x40000000;
+    /**
+     * @brief removeRemoteResponse
+     * @param id ID yang dihapus (tanpa flag)
+     * @param ext Flag ekstensi untuk ID
+     * @note TXB2 kembali dipakai untuk pengiriman biasa saat slot terakhir dihapus.
+     */
+    void removeRemoteResponse(uint32_t id, byte ext)
+    {
+        byte i = _rtrFind((id & 0x1FFFFFFF) | (ext ? 0x80000000 : 0));
+        if (i == 0xFF || _rtrCount == 0)
+            return;
+        _rtr[i].len = 0xFF;
+        if (_rtrStaged == i)
+            _rtrStaged = 0xFF;
+        if (--_rtrCount == 0)
+        {
+            _txReserved &= ~0x04;
+            __bitModify(CTR_TXB2CTRL, TXB_TXP_M, 0);
+        }
+    }
 
-        if (m_nDlc > 8)
-            m_nDlc = 8;
+#if defined(ARDUINO)
+    /**
+     * @brief useRtsPin
+     * @param pin Pin MCU yang terhubung ke pin TX2RTS MCP2515 (-1 = pakai instruksi SPI RTS)
+     * @return Kode status
+     * @note Pin TX2RTS dikonfigurasi sebagai pemicu TXB2 lewat CTR_TXRTSCTRL (B2RTSM), sehingga
+     * jawaban dikirim dengan satu pulsa GPIO tanpa transaksi SPI.
+     */
+    byte useRtsPin(int8_t pin)
+    {
+        byte res = _setCANCTRL(REQ_CONFIG);
+        if (res == RSPN_OK)
+        {
+            __bitModify(CTR_TXRTSCTRL, 0x04, (pin >= 0) ? 0x04 : 0x00);
+            res = _setCANCTRL(_opsModeUse);
+        }
+        if (res != RSPN_OK)
+            return res;
+        if (pin >= 0)
+        {
+            pinMode(pin, OUTPUT);
+            digitalWrite(pin, HIGH);
+        }
+        _rtrPin = pin;
+        return RSPN_OK;
+    }
+#endif
+
+    /**
+     * @brief rtrStats
+     * @return Statistik jawaban remote frame (jumlah dan latensi)
+     */
+    const RtrStats &rtrStats(void) const { return _rtrStats; }
+
+    /**
+     * @brief readData
+     * @param id Pointer ke ID dari data yang diterima
+     * @param len Pointer ke panjang data yang diterima
+     * @param buf Pointer ke buffer untuk menyimpan data yang diterima
+     * @return Kode status dari pembacaan data
+     * @note Fungsi ini digunakan untuk membaca data dari MCP2515.
+     */
+    byte readData(uint32_t *id, byte *len, byte *buf)
+    {
+        MCP2515Frame frame;
+        byte res = readFrame(frame);
 
-        *id = m_nID;
-        *len = m_nDlc;
+        if (res != RSPN_OK)
+            return res;
 
-        for (int i = 0; i < m_nDlc; i++)
-            buf[i] = m_nDta[i];
+        *id = frame.id;
+        *len = frame.len;
+        for (int i = 0; i < frame.len; i++)
+            buf[i] = frame.data[i];
+
+        return RSPN_OK;
+    }
+
+    /**
+     * @brief readFrame
+     * @param frame Frame untuk menyimpan data yang diterima
+     * @return RSPN_OK jika ada frame, RSPN_NOMSG jika tidak ada
+     * @note Jalur baca minimal: satu READ STATUS lalu satu READ RX BUFFER (2 transaksi SPI).
+     */
+    byte readFrame(MCP2515Frame &frame)
+    {
+        if (canError)
+            return 100;
+        byte stat = _readStatus();
+
+        if (stat & (1 << 0)) /* Msg in Buffer 0              */
+            _readRxBuffer(0, frame);
+        else if (stat & (1 << 1)) /* Msg in Buffer 1              */
+            _readRxBuffer(1, frame);
+        else
+            return RSPN_NOMSG;
+
+        if ((frame.id & 0x40000000) && _rtrCount)
+            _rtrRespond(frame);
 
         return RSPN_OK;
     }
@@ -943,5 +1946,126 @@ public:
         else
             return false;
     }
+
+    /**
+     * @brief setRxAdaptive
+     * @param highFps Laju frame (frame/detik) untuk pindah ke mode polling
+     * @param lowFps Laju frame untuk kembali ke mode IRQ
+     * @param budget Jumlah maksimum frame per panggilan rxService()
+     * @param windowUs Lama jendela pengukuran laju frame
+     * @note Mode awal adalah IRQ. highFps harus lebih besar dari lowFps agar mode tidak berosilasi.
+     */
+    void setRxAdaptive(uint32_t highFps, uint32_t lowFps, byte budget = 8, uint32_t windowUs = 10000)
+    {
+        _rxHighFps = highFps;
+        _rxLowFps = lowFps;
+        _rxBudget = budget ? budget : 1;
+        _rxWindowUs = windowUs ? windowUs : 1;
+    }
+
+    /**
+     * @brief rxIrq
+     * @note Panggil dari ISR pin INT (tepi turun). Tidak ada transaksi SPI di dalamnya.
+     */
+    void rxIrq(void) { _rxIrqPending = true; }
+
+    /**
+     * @brief rxService
+     * @param frames Array untuk menyimpan frame yang diterima
+     * @param max Ukuran array
+     * @return Jumlah frame yang dibaca
+     * @note Penerimaan adaptif (gaya NAPI). Mode IRQ: tanpa rxIrq() fungsi ini langsung kembali
+     * tanpa SPI. Saat laju frame mencapai highFps, RX0IE/RX1IE di CANINTE dimatikan dan setiap
+     * panggilan menguras RX buffer sampai budget tanpa menunggu INT. Saat laju turun sampai lowFps,
+     * interrupt RX dinyalakan lagi.
+     * @note Contoh:
+     *   attachInterrupt(digitalPinToInterrupt(INT_PIN), [] { can.rxIrq(); }, FALLING);
+     *   void loop() { n = can.rxService(f, 8); if (!n && !can.rxPolling()) sleep(); }
+     */
+    byte rxService(MCP2515Frame *frames, byte max)
+    {
+        if (canError)
+            return 0;
+        if (!_rxPolling && !_rxIrqPending)
+            return 0;
+
+        uint32_t start = _bus.micros();
+        byte limit = (max < _rxBudget) ? max : _rxBudget;
+        byte n = 0;
+
+        if (!_rxPolling)
+        {
+            _rxIrqPending = false; // ISR boleh menyetel lagi selama pengurasan
+            _rxStats.irqEvents++;
+        }
+        else
+            _rxStats.pollCalls++;
+
+        while (n < limit && readFrame(frames[n]) == RSPN_OK)
+            n++;
+
+        if (_rxPolling)
+        {
+            _rxStats.pollFrames += n;
+            if (n == 0)
+                _rxStats.emptyPolls++;
+        }
+        else
+        {
+            _rxStats.irqFrames += n;
+            if (n == 0)
+                _rxStats.spuriousIrq++;
+            else if (n == limit)
+                _rxIrqPending = true; // INT tetap aktif tanpa tepi baru, lanjutkan di panggilan berikutnya
+        }
+
+        uint32_t now = _bus.micros();
+        if (_rxPolling)
+            _rxStats.pollBusyUs += now - start;
+        else
+            _rxStats.irqBusyUs += now - start;
+
+        _rxWinFrames += n;
+        uint32_t elapsed = now - _rxWinStart;
+        if (elapsed >= _rxWindowUs)
+        {
+            _rxStats.rateFps = (uint32_t)((uint64_t)_rxWinFrames * 1000000UL / elapsed);
+            _rxWinStart = now;
+            _rxWinFrames = 0;
+
+            if (!_rxPolling && _rxStats.rateFps >= _rxHighFps)
+            {
+                __bitModify(CTR_CANINTE, INTF_RX0IF | INTF_RX1IF, 0);
+                _rxPolling = true;
+                _rxStats.toPoll++;
+            }
+            else if (_rxPolling && _rxStats.rateFps <= _rxLowFps)
+            {
+                // INT langsung aktif lagi jika masih ada RXnIF, tetapi ISR bisa melewatkan tepinya
+                __bitModify(CTR_CANINTE, INTF_RX0IF | INTF_RX1IF, INTF_RX0IF | INTF_RX1IF);
+                _rxPolling = false;
+                _rxIrqPending = true;
+                _rxStats.toIrq++;
+            }
+        }
+        return n;
+    }
+
+    /**
+     * @brief rxPolling
+     * @return true jika di mode polling (jangan menunggu INT, panggil rxService() terus)
+     */
+    bool rxPolling(void) const { return _rxPolling; }
+
+    /**
+     * @brief rxStats
+     * @return Statistik penerimaan adaptif (perpindahan mode, frame, dan waktu CPU per mode)
+     */
+    const RxStats &rxStats(void) const { return _rxStats; }
 };
+
+#if defined(ARDUINO)
+typedef MCP2515Base<MCP2515ArduinoSPI> MCP2515;
+#endif
+
 #endif